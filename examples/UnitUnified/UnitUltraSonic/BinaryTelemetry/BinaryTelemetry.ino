@@ -0,0 +1,16 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Example of the binary telemetry using M5UnitUnified for UnitUltraSonic I2C/IO
+*/
+// *********************************************************************
+// Choose connection
+// *********************************************************************
+#if !defined(CONNECT_VIA_I2C) && !defined(CONNECT_VIA_GPIO)
+// #define CONNECT_VIA_I2C
+// #define CONNECT_VIA_GPIO
+#endif
+#include "main/BinaryTelemetry.cpp"
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Example of the binary telemetry using M5UnitUnified for UnitUltraSonic I2C/IO
+  Samples are sent to the serial as the frames of 16 samples (about 4 bytes per sample with its time),
+  instead of the text (about 40 bytes per sample)
+  Decode on the host by tools/telemetry_decoder (e.g. telemetry_decoder /dev/ttyUSB0 115200)
+*/
+#include <M5Unified.h>
+#include <M5UnitUnified.h>
+#include <M5UnitUnifiedDISTANCE.h>
+#include <M5Utility.h>
+
+// *********************************************************************
+// Choose connection
+// *********************************************************************
+#if !defined(CONNECT_VIA_I2C) && !defined(CONNECT_VIA_GPIO)
+// #define CONNECT_VIA_I2C
+// #define CONNECT_VIA_GPIO
+#endif
+
+namespace {
+auto& lcd = M5.Display;
+m5::unit::UnitUnified Units;
+#if defined(CONNECT_VIA_I2C)
+m5::unit::UnitUltraSonicI2C unit;
+constexpr uint32_t interval{150};  // For I2C, the measurement interval is 150 ms or more
+#elif defined(CONNECT_VIA_GPIO)
+m5::unit::UnitUltraSonicIO unit;
+constexpr uint32_t interval{50};  // For GPIO, the measurement interval is 50 ms or more
+#else
+#error "Choose connection"
+#endif
+
+using namespace m5::unit::rcwl9620;
+
+constexpr uint8_t unit_id{0};
+constexpr size_t samples_per_frame{16};
+uint8_t frame[telemetry::max_frame_size(samples_per_frame)]{};
+telemetry::Encoder encoder(frame, sizeof(frame));
+uint32_t frames{};
+Data latest{};
+
+// Time of the sample (ms) by the time it was read
+uint32_t sample_millis(const Timestamp& ts)
+{
+    return m5::utility::millis() - (m5::utility::micros() - ts.read_us) / 1000U;
+}
+
+}  // namespace
+
+void setup()
+{
+    M5.begin();
+    // The screen shall be in landscape mode
+    if (lcd.height() > lcd.width()) {
+        lcd.setRotation(1);
+    }
+
+    auto cfg        = unit.config();
+    cfg.interval_ms = interval;
+    cfg.timestamp   = true;  // Time of each sample
+    unit.config(cfg);
+
+#if defined(CONNECT_VIA_I2C)
+    // PortA as I2C
+    auto pin_num_sda = M5.getPin(m5::pin_name_t::port_a_sda);
+    auto pin_num_scl = M5.getPin(m5::pin_name_t::port_a_scl);
+    M5_LOGI("getPin: SDA:%u SCL:%u", pin_num_sda, pin_num_scl);
+    Wire.end();
+    Wire.begin(pin_num_sda, pin_num_scl, 400 * 1000U);
+
+    if (!Units.add(unit, Wire) || !Units.begin()) {
+        M5_LOGE("Failed to begin");
+        lcd.clear(TFT_RED);
+        while (true) {
+            m5::utility::delay(10000);
+        }
+    }
+#elif defined(CONNECT_VIA_GPIO)
+    // PortB as GPIO if available, PortA if not
+    auto pin_num_gpio_in  = M5.getPin(m5::pin_name_t::port_b_in);
+    auto pin_num_gpio_out = M5.getPin(m5::pin_name_t::port_b_out);
+    if (pin_num_gpio_in < 0 || pin_num_gpio_out < 0) {
+        M5_LOGW("PortB is not available");
+        Wire.end();
+        pin_num_gpio_in  = M5.getPin(m5::pin_name_t::port_a_pin1);
+        pin_num_gpio_out = M5.getPin(m5::pin_name_t::port_a_pin2);
+    }
+    M5_LOGI("getPin :%d,%d", pin_num_gpio_in, pin_num_gpio_out);
+
+    if (!Units.add(unit, pin_num_gpio_in, pin_num_gpio_out) || !Units.begin()) {
+        M5_LOGE("Failed to begin");
+        lcd.clear(TFT_RED);
+        while (true) {
+            m5::utility::delay(10000);
+        }
+    }
+#endif
+
+    M5_LOGI("M5UnitUnified has been begun");
+    M5_LOGI("%s", Units.debugInfo().c_str());
+    // The serial is used only for the frames from now on
+    M5.Log.setLogLevel(m5::log_target_serial, ESP_LOG_NONE);
+
+    lcd.setFont(&fonts::AsciiFont8x16);
+    lcd.clear(TFT_DARKGREEN);
+    lcd.fillRect(8, 8, 8 * 24, 16 * 2, TFT_BLACK);
+}
+
+void loop()
+{
+    M5.update();
+    Units.update();
+    if (!unit.updated()) {
+        return;
+    }
+
+    while (unit.available()) {
+        const auto td     = unit.oldestTimed();
+        const uint32_t ms = sample_millis(td.timestamp);
+        if (!encoder.count()) {
+            telemetry::header_t h{};
+            h.unit_id      = unit_id;
+            h.timestamp_ms = ms;  // Time of the first sample
+            h.interval_ms  = unit.interval();
+            encoder.begin(h);
+        }
+        latest = td.data;
+        unit.discard();
+        encoder.push(latest.raw_distance(), ms);
+
+        if (encoder.count() >= samples_per_frame) {
+            Serial.write(frame, encoder.finish());
+            ++frames;
+        }
+    }
+
+    lcd.fillRect(8, 8, 8 * 24, 16 * 2, TFT_BLACK);
+    lcd.setCursor(8, 8 + 16 * 0);
+    lcd.printf("Distance:%.2f mm", latest.distance());
+    lcd.setCursor(8, 8 + 16 * 1);
+    lcd.printf("Frames:%u", frames);
+}
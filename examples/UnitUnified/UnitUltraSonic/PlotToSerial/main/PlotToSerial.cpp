@@ -109,12 +109,18 @@ void loop()
         lcd.printf("Distance:%.2f mm", unit.distance());
     }
 
+    // Single shot without blocking the loop, and then periodic again
     if (M5.BtnA.wasClicked() || touch.wasClicked()) {
-        unit.stopPeriodicMeasurement();
-        Data d{};
-        if (unit.measureSingleshot(d)) {
-            M5.Log.printf("Single: %.2f mm\n", d.distance());
-        }
-        unit.startPeriodicMeasurement(interval);
+        unit.requestStopPeriodicMeasurement([](m5::unit::UnitRCWL9620& u) {
+            auto ret = u.requestSingleshot([](m5::unit::UnitRCWL9620& u, const Data& d, const bool valid) {
+                if (valid) {
+                    M5.Log.printf("Single: %.2f mm\n", d.distance());
+                }
+                u.startPeriodicMeasurement(interval);
+            });
+            if (!ret) {
+                u.startPeriodicMeasurement(interval);
+            }
+        });
     }
 }
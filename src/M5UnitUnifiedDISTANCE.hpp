@@ -14,7 +14,11 @@
 #define M5_UNIT_UNIFIED_DISTANCE_HPP
 
 #include "unit/unit_RCWL9620.hpp"
+#include "unit/unit_RCWL9620_static.hpp"
 #include "unit/unit_UltraSonic.hpp"
+#include "unit/rcwl9620/scheduler.hpp"
+#include "unit/rcwl9620/pacer.hpp"
+#include "unit/rcwl9620/telemetry.hpp"
 
 /*!
   @namespace m5
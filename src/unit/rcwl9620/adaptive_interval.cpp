@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file adaptive_interval.cpp
+  @brief Adaptive measurement interval of RCWL9620
+*/
+#include "adaptive_interval.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+// For C++11/14
+constexpr uint8_t AdaptiveInterval::BINS;
+constexpr uint32_t AdaptiveInterval::BIN_MS;
+
+void AdaptiveInterval::start(const uint32_t max_ms, const uint32_t floor_ms)
+{
+    _min = std::max(_cfg.min_ms, floor_ms);
+    _max = _interval = std::max(max_ms, _min);
+    _latency_x16     = 0;
+    _successes = _failures = 0;
+    _histogram.fill(0);
+}
+
+void AdaptiveInterval::success(const uint32_t latency_ms, const bool first)
+{
+    ++_successes;
+    ++_histogram[std::min<uint32_t>(latency_ms / BIN_MS, BINS - 1)];
+    const uint32_t x16 = latency_ms << 4;
+    _latency_x16       = _latency_x16 ? _latency_x16 - (_latency_x16 >> 3) + (x16 >> 3) : x16;
+
+    // Try shorter if it was ready at the first read
+    if (first) {
+        _interval = std::max(_interval > _cfg.step_down_ms ? _interval - _cfg.step_down_ms : 0, _min);
+    }
+}
+
+void AdaptiveInterval::failure(const uint32_t elapsed_ms)
+{
+    ++_failures;
+    // Not ready at elapsed_ms, so the interval must be longer than it
+    _interval = std::min(std::max(_interval, elapsed_ms) + _cfg.step_up_ms, _max);
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file adaptive_interval.hpp
+  @brief Adaptive measurement interval of RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_ADAPTIVE_INTERVAL_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_ADAPTIVE_INTERVAL_HPP
+
+#include <cstdint>
+#include <array>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class AdaptiveInterval
+  @brief Learns the ranging latency and adjusts the measurement interval
+  @details The interval is shortened while the first read of the cycle succeeds,
+  and lengthened when it fails because the ranging has not been completed.
+  Latency is the time from the request to the successful read
+ */
+class AdaptiveInterval {
+public:
+    //! @brief Number of bins of the latency histogram
+    static constexpr uint8_t BINS{16};
+    //! @brief Width of a bin of the latency histogram (ms)
+    static constexpr uint32_t BIN_MS{10};
+
+    /*!
+      @struct config_t
+      @brief Settings of the adaptive interval
+     */
+    struct config_t {
+        //! Lower bound of the interval (ms), 0 means the minimum interval given to start()
+        uint32_t min_ms{0};
+        //! Interval is shortened by this on success (ms)
+        uint32_t step_down_ms{2};
+        //! Interval is lengthened by this on failure (ms)
+        uint32_t step_up_ms{10};
+    };
+
+    ///@name Settings
+    ///@{
+    /*! @brief Gets the configration */
+    inline config_t config() const
+    {
+        return _cfg;
+    }
+    //! @brief Set the configration
+    inline void config(const config_t& cfg)
+    {
+        _cfg = cfg;
+    }
+    ///@}
+
+    /*!
+      @brief Start learning
+      @param max_ms Upper bound and initial value of the interval (ms)
+      @param floor_ms Minimum interval (ms), config_t::min_ms below it is raised to it
+     */
+    void start(const uint32_t max_ms, const uint32_t floor_ms = 0);
+
+    /*!
+      @brief Successful read
+      @param latency_ms Time from the request (ms)
+      @param first Is it the first read of the cycle?
+     */
+    void success(const uint32_t latency_ms, const bool first);
+    /*!
+      @brief Failed read since the ranging has not been completed
+      @param elapsed_ms Time from the request (ms)
+     */
+    void failure(const uint32_t elapsed_ms);
+
+    //! @brief Current interval (ms)
+    inline uint32_t interval() const
+    {
+        return _interval;
+    }
+    //! @brief Lower bound of the interval in effect (ms)
+    inline uint32_t minimum() const
+    {
+        return _min;
+    }
+    //! @brief Learned latency (ms), average of the recent successful reads
+    inline uint32_t latency() const
+    {
+        return (_latency_x16 + 8) >> 4;
+    }
+    //! @brief Histogram of the latency, the last bin includes all above
+    inline const std::array<uint32_t, BINS>& histogram() const
+    {
+        return _histogram;
+    }
+    //! @brief Number of the successful reads
+    inline uint32_t successes() const
+    {
+        return _successes;
+    }
+    //! @brief Number of the failed reads
+    inline uint32_t failures() const
+    {
+        return _failures;
+    }
+
+private:
+    config_t _cfg{};
+    uint32_t _interval{}, _min{}, _max{};
+    uint32_t _latency_x16{};  // EMA (1/8) in 1/16 ms
+    std::array<uint32_t, BINS> _histogram{};
+    uint32_t _successes{}, _failures{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
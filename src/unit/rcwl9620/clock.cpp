@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file clock.cpp
+  @brief Time source of RCWL9620
+*/
+#include "clock.hpp"
+#include <M5Utility.hpp>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+types::elapsed_time_t Clock::millis() const
+{
+    return m5::utility::millis();
+}
+
+uint32_t Clock::micros() const
+{
+    return m5::utility::micros();
+}
+
+void Clock::delay(const uint32_t ms)
+{
+    m5::utility::delay(ms);
+}
+
+void Clock::delayMicroseconds(const uint32_t us)
+{
+    m5::utility::delayMicroseconds(us);
+}
+
+Clock& Clock::system()
+{
+    static Clock clock;
+    return clock;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file clock.hpp
+  @brief Time source of RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_CLOCK_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_CLOCK_HPP
+
+#include <M5UnitComponent.hpp>
+#include <M5Utility.hpp>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Clock
+  @brief Time and wait used by the unit
+  @details m5::utility by default. Derive it to run the unit on the other time (e.g. simulated time in the test)
+ */
+class Clock {
+public:
+    virtual ~Clock()
+    {
+    }
+
+    //! @brief Elapsed time (ms)
+    virtual types::elapsed_time_t millis() const;
+    //! @brief Elapsed time (us)
+    virtual uint32_t micros() const;
+    //! @brief Wait (ms)
+    virtual void delay(const uint32_t ms);
+    //! @brief Wait (us)
+    virtual void delayMicroseconds(const uint32_t us);
+
+    //! @brief Clock of m5::utility
+    static Clock& system();
+};
+
+/*!
+  @class ClockRef
+  @brief Attached clock, or m5::utility if none
+  @details Calls m5::utility directly without the virtual call unless a clock is attached
+ */
+class ClockRef {
+public:
+    //! @brief Attach the clock (nullptr to use m5::utility)
+    inline void attach(Clock* clock)
+    {
+        _clock = clock;
+    }
+    //! @brief Gets the attached clock, or Clock::system() if none
+    inline Clock& get() const
+    {
+        return _clock ? *_clock : Clock::system();
+    }
+
+    //! @brief Elapsed time (ms)
+    inline types::elapsed_time_t millis() const
+    {
+        return _clock ? _clock->millis() : m5::utility::millis();
+    }
+    //! @brief Elapsed time (us)
+    inline uint32_t micros() const
+    {
+        return _clock ? _clock->micros() : m5::utility::micros();
+    }
+    //! @brief Wait (ms)
+    inline void delay(const uint32_t ms) const
+    {
+        if (_clock) {
+            _clock->delay(ms);
+        } else {
+            m5::utility::delay(ms);
+        }
+    }
+    //! @brief Wait (us)
+    inline void delayMicroseconds(const uint32_t us) const
+    {
+        if (_clock) {
+            _clock->delayMicroseconds(us);
+        } else {
+            m5::utility::delayMicroseconds(us);
+        }
+    }
+
+private:
+    Clock* _clock{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
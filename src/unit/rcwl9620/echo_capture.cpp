@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file echo_capture.cpp
+  @brief Echo pulse capture for RCWL9620 via GPIO
+*/
+#include "echo_capture.hpp"
+#if defined(ARDUINO_ARCH_ESP32)
+#include <Arduino.h>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+bool EchoCaptureISR::begin()
+{
+    if (_pin < 0) {
+        return false;
+    }
+    if (!_attached) {
+        attachInterruptArg(digitalPinToInterrupt(_pin), on_change, this, CHANGE);
+        _attached = true;
+    }
+    return true;
+}
+
+void EchoCaptureISR::end()
+{
+    if (_attached) {
+        detachInterrupt(digitalPinToInterrupt(_pin));
+        _attached = false;
+    }
+    disarm();
+}
+
+void IRAM_ATTR EchoCaptureISR::on_change(void* arg)
+{
+    auto self = static_cast<EchoCaptureISR*>(arg);
+    self->edge(digitalRead(self->_pin), micros());
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file echo_capture.hpp
+  @brief Echo pulse capture for RCWL9620 via GPIO
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_ECHO_CAPTURE_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_ECHO_CAPTURE_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class EchoCapture
+  @brief Timestamps the edges of the echo pulse
+  @details Edges are fed by edge() from a pin-change ISR, a capture peripheral or a simulated pin source
+  @note edge() may be called from the ISR
+ */
+class EchoCapture {
+public:
+    //! @brief Capture state
+    enum class State : uint8_t {
+        Idle,      //!< Not armed
+        Armed,     //!< Waiting for the rising edge
+        Rising,    //!< Waiting for the falling edge
+        Captured,  //!< Pulse has been captured
+    };
+
+    virtual ~EchoCapture()
+    {
+    }
+
+    //! @brief Start capturing (e.g. attach the interrupt)
+    virtual bool begin()
+    {
+        return true;
+    }
+    //! @brief Stop capturing (e.g. detach the interrupt)
+    virtual void end()
+    {
+    }
+
+    /*!
+      @brief Arm for the next pulse
+      @param now_us Current time (us)
+      @note Arm before triggering so that the rising edge is not missed
+     */
+    inline void arm(const uint32_t now_us)
+    {
+        _armed_at = now_us;
+        _state    = State::Armed;
+    }
+    //! @brief Disarm
+    inline void disarm()
+    {
+        _state = State::Idle;
+    }
+    /*!
+      @brief Feed the edge
+      @param level Pin level after the edge
+      @param at_us Time of the edge (us)
+     */
+    inline void edge(const bool level, const uint32_t at_us)
+    {
+        if (level && _state == State::Armed) {
+            _rise  = at_us;
+            _state = State::Rising;
+        } else if (!level && _state == State::Rising) {
+            _fall  = at_us;
+            _state = State::Captured;
+        }
+    }
+
+    //! @brief Gets the state
+    inline State state() const
+    {
+        return _state;
+    }
+    //! @brief Is the pulse captured?
+    inline bool captured() const
+    {
+        return _state == State::Captured;
+    }
+    //! @brief Gets the time armed (us)
+    inline uint32_t armedAt() const
+    {
+        return _armed_at;
+    }
+    //! @brief Gets the captured pulse width (us)
+    inline uint32_t duration() const
+    {
+        return _fall - _rise;
+    }
+
+protected:
+    volatile State _state{State::Idle};
+    volatile uint32_t _rise{}, _fall{};
+    uint32_t _armed_at{};
+};
+
+#if defined(ARDUINO_ARCH_ESP32)
+/*!
+  @class EchoCaptureISR
+  @brief Echo pulse capture by pin-change interrupt
+  @details Timestamps both edges of the echo pin with micros() in the ISR
+ */
+class EchoCaptureISR : public EchoCapture {
+public:
+    //! @param pin Echo (RX) pin number
+    explicit EchoCaptureISR(const int pin) : EchoCapture(), _pin{pin}
+    {
+    }
+    virtual ~EchoCaptureISR()
+    {
+        end();
+    }
+    virtual bool begin() override;
+    virtual void end() override;
+
+    //! @brief Gets the echo pin number
+    inline int pin() const
+    {
+        return _pin;
+    }
+
+protected:
+    static void on_change(void* arg);
+
+private:
+    int _pin{-1};
+    bool _attached{};
+};
+#endif
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
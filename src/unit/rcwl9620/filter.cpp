@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file filter.cpp
+  @brief Streaming filter for the distance of RCWL9620
+*/
+#include "filter.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+// For C++11/14
+constexpr uint8_t Filter::MAX_WINDOW;
+
+void Filter::config(const config_t& cfg)
+{
+    _cfg = cfg;
+    if (_cfg.window) {
+        _cfg.window = std::max<uint8_t>(std::min<uint8_t>(_cfg.window | 1, MAX_WINDOW), 3);
+    }
+    _cfg.ema_alpha = std::min<uint16_t>(_cfg.ema_alpha, 256);
+    reset();
+}
+
+void Filter::reset()
+{
+    _count = _pos = 0;
+    _ema          = 0;
+    _ema_valid    = false;
+}
+
+uint32_t Filter::apply(const uint32_t um, bool& outlier)
+{
+    outlier    = false;
+    uint32_t v = um;
+
+    if (_cfg.window) {
+        insert(um);
+        const uint32_t med = median();
+        if (_cfg.outlier_k && _count >= 3) {
+            // sigma is approximately 1.4826 x MAD for normal distribution (1.5 here)
+            const uint32_t mad       = this->mad();
+            const uint32_t sigma     = mad + (mad >> 1);
+            const uint32_t threshold = std::max(_cfg.outlier_min_um, sigma / 10 * _cfg.outlier_k);
+            const uint32_t deviation = um > med ? um - med : med - um;
+            if (deviation > threshold) {
+                outlier = true;
+                v       = med;
+            }
+        }
+        if (_cfg.median) {
+            v = med;
+        }
+    }
+
+    if (_cfg.ema_alpha) {
+        if (!_ema_valid) {
+            _ema       = static_cast<int32_t>(v);
+            _ema_valid = true;
+        } else {
+            // Fits in int32 for the measurable range (up to 4500000 um)
+            _ema += ((static_cast<int32_t>(v) - _ema) * _cfg.ema_alpha) / 256;
+        }
+        v = static_cast<uint32_t>(_ema);
+    }
+    return v;
+}
+
+uint32_t Filter::mad() const
+{
+    if (!_count) {
+        return 0;
+    }
+    // Deviations on each side of the median are already sorted, merge them up to the middle
+    const int32_t mid  = (_count - 1) >> 1;
+    const uint32_t med = _sorted[mid];
+    int32_t lo{mid - 1}, hi{mid + 1};
+    uint32_t dev{};  // Deviation of the median itself
+    for (int32_t i = 0; i < mid; ++i) {
+        const uint32_t dl = lo >= 0 ? med - _sorted[lo] : UINT32_MAX;
+        const uint32_t dh = hi < _count ? _sorted[hi] - med : UINT32_MAX;
+        if (dl <= dh) {
+            dev = dl;
+            --lo;
+        } else {
+            dev = dh;
+            ++hi;
+        }
+    }
+    return dev;
+}
+
+void Filter::insert(const uint32_t um)
+{
+    auto first = _sorted.begin();
+    auto last  = first + _count;
+    if (_count == _cfg.window) {
+        // Replace the oldest, shifting only the elements between the old and new positions
+        auto it  = std::lower_bound(first, last, _ring[_pos]);
+        auto ins = std::lower_bound(first, last, um);
+        if (ins > it) {
+            std::move(it + 1, ins, it);
+            *(ins - 1) = um;
+        } else {
+            std::move_backward(ins, it, it + 1);
+            *ins = um;
+        }
+    } else {
+        auto ins = std::upper_bound(first, last, um);
+        std::move_backward(ins, last, last + 1);
+        *ins = um;
+        ++_count;
+    }
+    _ring[_pos] = um;
+    _pos        = (_pos + 1 < _cfg.window) ? _pos + 1 : 0;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
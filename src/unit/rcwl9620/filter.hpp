@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file filter.hpp
+  @brief Streaming filter for the distance of RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_FILTER_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_FILTER_HPP
+
+#include <cstdint>
+#include <array>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Filter
+  @brief Running median, outlier gate (Hampel) and EMA for the distance
+  @details Stages are applied in the order of outlier gate, median, EMA.
+  The window is kept sorted incrementally, so each sample costs a binary search and
+  a shift of at most the window size, without allocation
+ */
+class Filter {
+public:
+    //! @brief Maximum window size
+    static constexpr uint8_t MAX_WINDOW{15};
+
+    /*!
+      @struct config_t
+      @brief Settings of the filter
+     */
+    struct config_t {
+        //! Window size (odd, 3 - MAX_WINDOW), 0 disables median and outlier gate
+        uint8_t window{0};
+        //! Output the running median of the window?
+        bool median{false};
+        //! Threshold of the outlier gate in sigma x10 (e.g. 30 for 3 sigma), 0 is disabled
+        uint8_t outlier_k{0};
+        //! Deviation under this is not regarded as outlier (um)
+        uint32_t outlier_min_um{10000};
+        //! Weight of the new value of EMA (1 - 256, /256), 0 is disabled
+        uint16_t ema_alpha{0};
+    };
+
+    Filter()
+    {
+    }
+    explicit Filter(const config_t& cfg)
+    {
+        config(cfg);
+    }
+
+    ///@name Settings
+    ///@{
+    /*! @brief Gets the configration */
+    inline config_t config() const
+    {
+        return _cfg;
+    }
+    /*!
+      @brief Set the configration
+      @note The state is reset
+     */
+    void config(const config_t& cfg);
+    //! @brief Is any stage enabled?
+    inline bool enabled() const
+    {
+        return enabled(_cfg);
+    }
+    //! @brief Is any stage enabled by the settings?
+    inline static bool enabled(const config_t& cfg)
+    {
+        return (cfg.window && (cfg.median || cfg.outlier_k)) || cfg.ema_alpha;
+    }
+    ///@}
+
+    //! @brief Reset the state
+    void reset();
+
+    /*!
+      @brief Apply the filter to the sample
+      @param um Distance (um) in the measurable range
+      @param[out] outlier True if the sample is rejected as outlier
+      @return Filtered distance (um)
+     */
+    uint32_t apply(const uint32_t um, bool& outlier);
+
+    ///@name State
+    ///@{
+    //! @brief Number of samples in the window
+    inline uint8_t count() const
+    {
+        return _count;
+    }
+    //! @brief Median of the window (um)
+    inline uint32_t median() const
+    {
+        return _count ? _sorted[(_count - 1) >> 1] : 0;
+    }
+    //! @brief Median absolute deviation of the window (um)
+    uint32_t mad() const;
+    ///@}
+
+protected:
+    void insert(const uint32_t um);
+
+private:
+    config_t _cfg{};
+    std::array<uint32_t, MAX_WINDOW> _ring{};    // In order of arrival
+    std::array<uint32_t, MAX_WINDOW> _sorted{};  // Sorted
+    uint8_t _count{}, _pos{};
+    int32_t _ema{};
+    bool _ema_valid{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file interface.cpp
+  @brief Interfaces of RCWL9620 for I2C and GPIO
+*/
+#include "interface.hpp"
+#include <algorithm>
+
+using namespace m5::unit::rcwl9620::command;
+
+namespace {
+// Maximum time from trigger to the rising edge of echo (us)
+constexpr uint32_t echo_trigger_us{10000};
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+// class InterfaceI2C
+InterfaceI2C::InterfaceI2C(UnitRCWL9620& u) : UnitRCWL9620::Interface(u)
+{
+    _readiness.config(u.config().readiness);
+}
+
+bool InterfaceI2C::read_measurement(Data& d, bool& timeouted)
+{
+    timeouted = false;
+    std::fill(d.raw.begin(), d.raw.end(), 0x00);
+    for (;;) {
+        auto now = clock().micros();
+        switch (_readiness.poll(now)) {
+            case Readiness::State::Expired:
+                // Data is invalid, and the next request can be issued
+                M5_LIB_LOGD("Not ready within the deadline");
+                _readiness.expired();
+                _requested = false;
+                timeouted  = true;
+                return true;
+            case Readiness::State::Wait:
+                if (_readiness.config().mode != Readiness::Mode::Polling) {
+                    return false;  // Try again on the later call
+                }
+                clock().delayMicroseconds(_readiness.remaining(now));
+                continue;
+            default:
+                break;
+        }
+        if (read_raw(d.raw.data(), d.raw.size())) {
+            bus_transfer(1 + d.raw.size());  // Address and the data
+            _readiness.acked();
+            _requested = false;
+            return true;
+        }
+        // NACK while ranging
+        bus_transfer(1);
+        now = clock().micros();
+        _readiness.nacked(now);
+        // Given up in this call if the deadline is already exceeded
+        if (_readiness.config().mode != Readiness::Mode::Polling && _readiness.poll(now) != Readiness::State::Expired) {
+            return false;
+        }
+    }
+}
+
+bool InterfaceI2C::request_measurement()
+{
+    if (!_requested) {
+        _requested = write_command(MEASURE_DISTANCE);
+        bus_transfer(_requested ? 2 : 1);  // Address and the command
+        if (_requested) {
+            _request_us = clock().micros();
+            _readiness.requested(_request_us);
+        }
+    }
+    return _requested;
+}
+
+void InterfaceI2C::recover()
+{
+    reset();
+    // Read out the data to release the device left in the middle of the transfer
+    uint8_t buf[3]{};
+    bus_transfer(read_raw(buf, sizeof(buf)) ? 1 + sizeof(buf) : 1);
+}
+
+bool InterfaceI2C::write_command(const uint8_t cmd)
+{
+    return _unit.writeRegister(cmd, nullptr, 0);
+}
+
+bool InterfaceI2C::read_raw(uint8_t* buf, const size_t len)
+{
+    return _unit.readWithTransaction(buf, len) == m5::hal::error::error_t::OK;
+}
+
+// class InterfaceGPIO
+InterfaceGPIO::InterfaceGPIO(UnitRCWL9620& u, EchoCapture* capture) : UnitRCWL9620::Interface(u), _capture{capture}
+{
+    _unit.pinModeRX(gpio::Mode::Input);
+    _unit.pinModeTX(gpio::Mode::Output);
+    _unit.writeDigitalTX(false);
+    if (_capture && !_capture->begin()) {
+        M5_LIB_LOGE("Failed to begin the echo capture");
+        _capture = nullptr;
+    }
+}
+
+InterfaceGPIO::~InterfaceGPIO()
+{
+    if (_capture) {
+        _capture->end();
+    }
+}
+
+bool InterfaceGPIO::read_measurement(Data& d, bool& timeouted)
+{
+    timeouted = false;
+    return _capture ? collect(d, timeouted) : measure(d);
+}
+
+bool InterfaceGPIO::request_measurement()
+{
+    // Ignored because request and read are not separated by GPIO without capture
+    if (_capture) {
+        _capture->arm(clock().micros());
+        trigger();
+    }
+    return true;
+}
+
+uint32_t InterfaceGPIO::remaining_us(const uint32_t now_us) const
+{
+    if (!in_flight() || _capture->captured()) {
+        return 0;
+    }
+    // Checked every millisecond in the echo window, and given up at the end of it
+    const uint32_t elapsed = now_us - _capture->armedAt();
+    const uint32_t window  = _unit.echoTimeout_us() + echo_trigger_us;
+    return elapsed < window ? std::min<uint32_t>(window - elapsed, 1000U) : 0;
+}
+
+void InterfaceGPIO::reset()
+{
+    if (_capture) {
+        _capture->disarm();
+    }
+}
+
+void InterfaceGPIO::write_trigger(const bool high)
+{
+    _unit.writeDigitalTX(high);
+}
+
+bool InterfaceGPIO::pulse_in(uint32_t& duration, const uint32_t timeout_us)
+{
+    return _unit.pulseInRX(duration, HIGH, timeout_us);
+}
+
+void InterfaceGPIO::trigger()
+{
+    _request_us = clock().micros();
+    write_trigger(LOW);
+    clock().delayMicroseconds(2);
+    write_trigger(HIGH);
+    clock().delayMicroseconds(10);
+    write_trigger(LOW);
+}
+
+bool InterfaceGPIO::measure(Data& d)
+{
+    std::fill(d.raw.begin(), d.raw.end(), 0x00);
+
+    // Request
+    trigger();
+
+    // Read
+    uint32_t duration{};
+    if (!pulse_in(duration, _unit.echoTimeout_us())) {
+        return false;
+    }
+    store(d, duration);
+    return true;
+}
+
+bool InterfaceGPIO::collect(Data& d, bool& timeouted)
+{
+    std::fill(d.raw.begin(), d.raw.end(), 0x00);
+
+    if (_capture->captured()) {
+        store(d, _capture->duration());
+        _capture->disarm();
+        return true;
+    }
+    if (_capture->state() == EchoCapture::State::Idle) {
+        return false;  // Not requested
+    }
+    // Give up the pulse that is not completed within the timeout
+    if (clock().micros() - _capture->armedAt() > _unit.echoTimeout_us() + echo_trigger_us) {
+        _capture->disarm();
+        timeouted = true;
+        return true;
+    }
+    return false;  // Not yet
+}
+
+void InterfaceGPIO::store(Data& d, const uint32_t duration)
+{
+    const uint32_t distance_um = tof_to_um(duration, _unit.speedOfSound());
+    d.raw[0]                   = (distance_um >> 16) & 0xFF;
+    d.raw[1]                   = (distance_um >> 8) & 0xFF;
+    d.raw[2]                   = distance_um & 0xFF;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file interface.hpp
+  @brief Interfaces of RCWL9620 for I2C and GPIO
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_INTERFACE_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_INTERFACE_HPP
+
+#include "../unit_RCWL9620.hpp"
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class InterfaceI2C
+  @brief Request and read of RCWL9620 via I2C
+  @details Bus access is done by write_command() and read_raw(),
+  which can be overridden for the simulated unit (e.g. native test)
+ */
+class InterfaceI2C : public UnitRCWL9620::Interface {
+public:
+    explicit InterfaceI2C(UnitRCWL9620& u);
+    virtual ~InterfaceI2C()
+    {
+    }
+    virtual bool read_measurement(Data& d, bool& timeouted) override;
+    virtual bool request_measurement() override;
+    inline virtual void reset() override
+    {
+        _requested = false;
+        _readiness.discarded();
+    }
+    virtual void recover() override;
+    inline virtual Readiness::counters_t counters() const override
+    {
+        return _readiness.counters();
+    }
+    inline virtual uint32_t ranging_time() const override
+    {
+        // Datasheet says
+        // 向模块写入 0X01 ，模块开始测距；等待 100mS 模块最大测距时间
+        return 100;
+    }
+    inline virtual bool in_flight() const override
+    {
+        return _requested;
+    }
+    inline virtual uint32_t remaining_us(const uint32_t now_us) const override
+    {
+        // Backoff after NACK
+        return _requested ? _readiness.remaining(now_us) : 0;
+    }
+
+protected:
+    //! @brief Write the command
+    virtual bool write_command(const uint8_t cmd);
+    //! @brief Read the raw data, false if NACKed
+    virtual bool read_raw(uint8_t* buf, const size_t len);
+
+    bool _requested{};
+    Readiness _readiness{};
+};
+
+/*!
+  @class InterfaceGPIO
+  @brief Trigger and echo of RCWL9620 via GPIO
+  @details Pin access is done by write_trigger() and pulse_in(),
+  which can be overridden for the simulated unit (e.g. native test)
+ */
+class InterfaceGPIO : public UnitRCWL9620::Interface {
+public:
+    InterfaceGPIO(UnitRCWL9620& u, EchoCapture* capture);
+    virtual ~InterfaceGPIO();
+    virtual bool read_measurement(Data& d, bool& timeouted) override;
+    virtual bool request_measurement() override;
+    virtual void reset() override;
+    inline virtual uint32_t ranging_time() const override
+    {
+        // Measured in read_measurement
+        return 0;
+    }
+    inline virtual bool in_flight() const override
+    {
+        // No request without the capture, read_measurement() triggers by itself
+        return _capture && _capture->state() != EchoCapture::State::Idle;
+    }
+    virtual uint32_t remaining_us(const uint32_t now_us) const override;
+
+protected:
+    //! @brief Write the level of the trigger pin
+    virtual void write_trigger(const bool high);
+    /*!
+      @brief Wait for the echo pulse and measure its width
+      @param[out] duration Pulse width (us)
+      @param timeout_us Give up if not completed within this time (us)
+      @return True if measured
+     */
+    virtual bool pulse_in(uint32_t& duration, const uint32_t timeout_us);
+
+    void trigger();
+    // Trigger and wait for the echo pulse
+    bool measure(Data& d);
+    // Collect the captured echo pulse
+    bool collect(Data& d, bool& timeouted);
+    void store(Data& d, const uint32_t duration);
+
+private:
+    EchoCapture* _capture{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
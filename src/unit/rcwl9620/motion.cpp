@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file motion.cpp
+  @brief Velocity and time-to-contact estimation for RCWL9620
+*/
+#include "motion.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+void Motion::config(const config_t& cfg)
+{
+    _cfg       = cfg;
+    _cfg.alpha = std::min<uint16_t>(_cfg.alpha, 256);
+    _cfg.beta  = std::min<uint16_t>(_cfg.beta, 256);
+    _alpha     = _cfg.alpha / 256.f;
+    _beta      = _cfg.beta / 256.f;
+    reset();
+}
+
+void Motion::reset()
+{
+    _x = _v = 0.0f;
+    _at_us = _count = 0;
+}
+
+void Motion::update(const uint32_t um, const uint32_t at_us)
+{
+    const float z = um / 1000.f;
+    const uint32_t dt_us{at_us - _at_us};
+    if (!_count || dt_us > _cfg.reset_gap_ms * 1000U) {
+        // (Re)start from the sample
+        _x     = z;
+        _v     = 0.0f;
+        _at_us = at_us;
+        _count = 1;
+        return;
+    }
+    if (!dt_us) {
+        return;  // Unable to predict
+    }
+    const float dt = dt_us * 1e-6f;
+    if (_count == 1) {
+        // Velocity from the first two samples
+        _v = (z - _x) / dt;
+        _x = z;
+    } else {
+        const float predicted = _x + _v * dt;
+        const float residual  = z - predicted;
+        _x                    = predicted + _alpha * residual;
+        _v += _beta * residual / dt;
+    }
+    _at_us = at_us;
+    ++_count;
+}
+
+float Motion::timeToContact_ms(const float contact_mm) const
+{
+    if (_count < 2 || _v >= 0.0f) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return _x <= contact_mm ? 0.0f : (_x - contact_mm) / -_v * 1000.f;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
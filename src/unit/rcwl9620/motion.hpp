@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file motion.hpp
+  @brief Velocity and time-to-contact estimation for RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_MOTION_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_MOTION_HPP
+
+#include <cstdint>
+#include <limits>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Motion
+  @brief Alpha-beta filter of the distance and its velocity
+  @details Each sample is predicted by the elapsed time from the previous one and corrected by the residual,
+  so irregular intervals are handled. Each sample costs a few float operations, without allocation
+ */
+class Motion {
+public:
+    /*!
+      @struct config_t
+      @brief Settings of the estimation
+     */
+    struct config_t {
+        //! Gain of the distance (1 - 256, /256), 0 disables the estimation
+        uint16_t alpha{0};
+        //! Gain of the velocity (0 - 256, /256), smaller is smoother but slower to follow
+        uint16_t beta{0};
+        //! Restart the estimation if the interval of the samples is longer than this (ms)
+        uint32_t reset_gap_ms{1000};
+    };
+
+    Motion()
+    {
+    }
+    explicit Motion(const config_t& cfg)
+    {
+        config(cfg);
+    }
+
+    ///@name Settings
+    ///@{
+    /*! @brief Gets the configration */
+    inline config_t config() const
+    {
+        return _cfg;
+    }
+    /*!
+      @brief Set the configration
+      @note The state is reset
+     */
+    void config(const config_t& cfg);
+    //! @brief Is the estimation enabled?
+    inline bool enabled() const
+    {
+        return enabled(_cfg);
+    }
+    //! @brief Is the estimation enabled by the settings?
+    inline static bool enabled(const config_t& cfg)
+    {
+        return cfg.alpha;
+    }
+    ///@}
+
+    //! @brief Reset the state
+    void reset();
+
+    /*!
+      @brief Update the estimation by the sample
+      @param um Distance (um)
+      @param at_us Time of the sample (us)
+     */
+    void update(const uint32_t um, const uint32_t at_us);
+
+    ///@name Estimation
+    ///@{
+    //! @brief Number of samples since the (re)start, the velocity is estimated from 2
+    inline uint32_t count() const
+    {
+        return _count;
+    }
+    //! @brief Estimated distance (mm), NaN if no sample
+    inline float distance() const
+    {
+        return _count ? _x : std::numeric_limits<float>::quiet_NaN();
+    }
+    //! @brief Estimated velocity (mm/s, negative if approaching), NaN if less than 2 samples
+    inline float velocity_mm_s() const
+    {
+        return _count >= 2 ? _v : std::numeric_limits<float>::quiet_NaN();
+    }
+    /*!
+      @brief Estimated time until the distance reaches the contact distance (ms)
+      @param contact_mm Contact distance (mm)
+      @return NaN if not approaching or not estimated, 0 if already reached
+     */
+    float timeToContact_ms(const float contact_mm = 0.0f) const;
+    ///@}
+
+private:
+    config_t _cfg{};
+    float _alpha{}, _beta{};
+    float _x{}, _v{};  // mm, mm/s
+    uint32_t _at_us{}, _count{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file pacer.cpp
+  @brief Updates multiple RCWL9620 only when due
+*/
+#include "pacer.hpp"
+#include <algorithm>
+
+using namespace m5::unit::types;
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+void Pacer::add(UnitRCWL9620& unit)
+{
+    _units.push_back(&unit);
+    _next_due = 0;  // Refresh on the next update
+}
+
+void Pacer::clear()
+{
+    _units.clear();
+    _next_due = 0;
+}
+
+uint32_t Pacer::update(const bool force)
+{
+    const elapsed_time_t now = _clock.millis();
+    if (!force && now < _next_due) {
+        return 0;
+    }
+
+    uint32_t cnt{};
+    elapsed_time_t due{NO_DUE};
+    for (auto&& u : _units) {
+        if (force || now >= u->nextDue()) {
+            u->update();
+            ++cnt;
+        }
+        due = std::min(due, u->nextDue());
+    }
+    _next_due = due;
+    return cnt;
+}
+
+uint32_t Pacer::sleep(const uint32_t max_ms)
+{
+    const elapsed_time_t now = _clock.millis();
+    if (now >= _next_due) {
+        return 0;
+    }
+    const uint32_t ms = std::min<elapsed_time_t>(_next_due - now, max_ms);
+    _clock.delay(ms);
+    return ms;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file pacer.hpp
+  @brief Updates multiple RCWL9620 only when due
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_PACER_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_PACER_HPP
+
+#include "../unit_RCWL9620.hpp"
+#include <vector>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Pacer
+  @brief Updates the units only when due, and sleeps until the earliest due
+  @details The earliest due of the units is kept, so update() before it costs a single comparison
+  regardless of the number of units. Units not due are skipped by comparing their nextDue()
+  @note Use for units that are not updated by UnitUnified (component_config_t::self_update is true)
+  @note Call update() again after changing the state of the unit (e.g. start periodic measurement)
+  with force true, since the earliest due is refreshed only by update()
+  @warning The lifetime of the units must be longer than the pacer
+ */
+class Pacer {
+public:
+    ///@name Units
+    ///@{
+    //! @brief Add the unit
+    void add(UnitRCWL9620& unit);
+    //! @brief Remove all units
+    void clear();
+    //! @brief Number of units
+    inline size_t size() const
+    {
+        return _units.size();
+    }
+    ///@}
+
+    /*!
+      @brief Update the units that are due
+      @param force Update all units regardless of the due, and refresh the earliest due
+      @return Number of units updated
+     */
+    uint32_t update(const bool force = false);
+    //! @brief Earliest due of the units (ms), rcwl9620::NO_DUE if nothing is scheduled
+    inline types::elapsed_time_t nextDue() const
+    {
+        return _next_due;
+    }
+    /*!
+      @brief Sleep until the earliest due
+      @param max_ms Upper bound of the sleep (ms)
+      @return Slept time (ms)
+      @note On FreeRTOS the task is blocked, so the idle task (and the light sleep if enabled) can run
+     */
+    uint32_t sleep(const uint32_t max_ms = 1000);
+
+    /*!
+      @brief Attach the clock
+      @param clock Clock used for the due and the sleep (nullptr to use m5::utility)
+      @note Use the same clock as the units
+      @warning The lifetime of the clock must be longer than the pacer
+     */
+    inline void attachClock(Clock* clock)
+    {
+        _clock.attach(clock);
+    }
+
+private:
+    std::vector<UnitRCWL9620*> _units{};
+    ClockRef _clock{};  // m5::utility if not attached
+    types::elapsed_time_t _next_due{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
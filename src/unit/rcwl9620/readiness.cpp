@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file readiness.cpp
+  @brief Readiness polling of RCWL9620 via I2C
+*/
+#include "readiness.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+void Readiness::requested(const uint32_t now_us)
+{
+    _retry_us   = now_us;
+    _backoff_us = 0;
+    _requested  = true;
+    _nacked     = false;
+}
+
+Readiness::State Readiness::poll(const uint32_t now_us) const
+{
+    if (!_requested) {
+        return State::Read;
+    }
+    if (_nacked && now_us - _nacked_us >= _cfg.deadline_ms * 1000U) {
+        return State::Expired;
+    }
+    // Signed difference for the wrap around of micros
+    return static_cast<int32_t>(now_us - _retry_us) >= 0 ? State::Read : State::Wait;
+}
+
+uint32_t Readiness::remaining(const uint32_t now_us) const
+{
+    const int32_t diff = static_cast<int32_t>(_retry_us - now_us);
+    return diff > 0 ? static_cast<uint32_t>(diff) : 0;
+}
+
+void Readiness::acked()
+{
+    ++_counters.reads;
+    _counters.retries += _nacked;
+    _requested = _nacked = false;
+}
+
+void Readiness::nacked(const uint32_t now_us)
+{
+    ++_counters.reads;
+    ++_counters.nacks;
+    _counters.retries += _nacked;
+    if (!_nacked) {
+        _nacked_us = now_us;
+    }
+    _nacked     = true;
+    _backoff_us = _backoff_us ? std::min(_backoff_us * 2, _cfg.backoff_max_ms * 1000U) : _cfg.backoff_min_ms * 1000U;
+    _retry_us   = now_us + _backoff_us;
+}
+
+void Readiness::expired()
+{
+    ++_counters.dropped;
+    _requested = _nacked = false;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
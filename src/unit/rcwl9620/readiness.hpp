@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file readiness.hpp
+  @brief Readiness polling of RCWL9620 via I2C
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_READINESS_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_READINESS_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Readiness
+  @brief Decides when to read the result of the request
+  @details The unit NACKs while ranging. After a NACK, the next read waits for the backoff,
+  which doubles up to the maximum. The request is given up when the deadline from the first NACK is exceeded,
+  so the first read always happens however late it is (e.g. the interval longer than the deadline)
+ */
+class Readiness {
+public:
+    //! @brief Strategy
+    enum class Mode : uint8_t {
+        Deferred,  //!< Reads at most once per call, retried on a later call after the backoff
+        Polling,   //!< Polls in the call with the backoff until ready or the deadline (blocking)
+    };
+    //! @brief Next action
+    enum class State : uint8_t {
+        Wait,     //!< Backoff is not elapsed
+        Read,     //!< Should read
+        Expired,  //!< Deadline is exceeded, give up the request
+    };
+
+    /*!
+      @struct config_t
+      @brief Settings of the readiness
+     */
+    struct config_t {
+        //! Strategy
+        Mode mode{Mode::Deferred};
+        //! Give up if not ready within this time from the first NACKed read (ms)
+        uint32_t deadline_ms{250};
+        //! Backoff after the first NACK (ms)
+        uint32_t backoff_min_ms{2};
+        //! Upper bound of the backoff (ms)
+        uint32_t backoff_max_ms{16};
+    };
+
+    /*!
+      @struct counters_t
+      @brief Counters for tuning the bus load
+     */
+    struct counters_t {
+        uint32_t reads{};    //!< Read transactions
+        uint32_t retries{};  //!< Read transactions after NACK for the same request
+        uint32_t nacks{};    //!< NACKed reads
+        uint32_t dropped{};  //!< Requests given up
+    };
+
+    ///@name Settings
+    ///@{
+    /*! @brief Gets the configration */
+    inline config_t config() const
+    {
+        return _cfg;
+    }
+    //! @brief Set the configration
+    inline void config(const config_t& cfg)
+    {
+        _cfg = cfg;
+    }
+    ///@}
+
+    //! @brief Gets the counters
+    inline const counters_t& counters() const
+    {
+        return _counters;
+    }
+    //! @brief Reset the counters
+    inline void resetCounters()
+    {
+        _counters = counters_t{};
+    }
+
+    ///@name For the interface
+    ///@{
+    //! @brief The request has been issued
+    void requested(const uint32_t now_us);
+    //! @brief The request has been discarded
+    inline void discarded()
+    {
+        _requested = false;
+    }
+    //! @brief Next action
+    State poll(const uint32_t now_us) const;
+    //! @brief Time until the next read (us)
+    uint32_t remaining(const uint32_t now_us) const;
+    //! @brief The read has been acknowledged
+    void acked();
+    //! @brief The read has been NACKed
+    void nacked(const uint32_t now_us);
+    //! @brief The request has been given up
+    void expired();
+    ///@}
+
+private:
+    config_t _cfg{};
+    counters_t _counters{};
+    uint32_t _nacked_us{}, _retry_us{}, _backoff_us{};
+    bool _requested{}, _nacked{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file recovery.cpp
+  @brief Recovery of the periodic measurement of RCWL9620
+*/
+#include "recovery.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+void Recovery::begin(const uint32_t now)
+{
+    _counters   = counters_t{};
+    _service    = true;
+    _recovering = false;
+    _service_ms = _down_ms = 0;
+    _service_at            = now;
+}
+
+void Recovery::end(const uint32_t now)
+{
+    if (_recovering) {
+        _down_ms += now - _down_at;
+        _recovering = false;
+    }
+    if (_service) {
+        _service_ms += now - _service_at;
+        _service = false;
+    }
+}
+
+void Recovery::fault(const uint32_t now)
+{
+    if (_recovering) {
+        return;
+    }
+    ++_counters.faults;
+    _recovering       = true;
+    _down_at          = now;
+    _backoff          = std::max<uint32_t>(_cfg.initial_ms, 1);
+    _next             = now + _backoff;
+    _episode_attempts = 0;
+}
+
+bool Recovery::failed(const uint32_t now)
+{
+    ++_counters.attempts;
+    ++_episode_attempts;
+    if (_cfg.max_attempts && _episode_attempts >= _cfg.max_attempts) {
+        ++_counters.gave_up;
+        end(now);
+        return false;
+    }
+    // Doubled up to the upper bound
+    _backoff = std::max<uint32_t>((_backoff >= _cfg.max_ms / 2) ? _cfg.max_ms : _backoff * 2, 1);
+    _next    = now + _backoff;
+    return true;
+}
+
+void Recovery::recovered(const uint32_t now)
+{
+    ++_counters.attempts;
+    ++_counters.recoveries;
+    _down_ms += now - _down_at;
+    _recovering = false;
+}
+
+uint32_t Recovery::downtime(const uint32_t now) const
+{
+    return _down_ms + (_recovering ? now - _down_at : 0);
+}
+
+uint32_t Recovery::uptime(const uint32_t now) const
+{
+    return _service_ms + (_service ? now - _service_at : 0) - downtime(now);
+}
+
+float Recovery::availability(const uint32_t now) const
+{
+    const uint32_t total = _service_ms + (_service ? now - _service_at : 0);
+    return total ? (float)uptime(now) / total : 1.0f;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
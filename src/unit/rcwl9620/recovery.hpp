@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file recovery.hpp
+  @brief Recovery of the periodic measurement of RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_RECOVERY_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_RECOVERY_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Recovery
+  @brief Retries the failed measurement with the bounded exponential backoff
+  @details The backoff is doubled on each failed attempt up to config_t::max_ms.
+  The time in service and in recovery are accumulated for the availability
+  @note Time is given by the caller (ms)
+ */
+class Recovery {
+public:
+    /*!
+      @struct config_t
+      @brief Settings of the recovery
+     */
+    struct config_t {
+        //! Recover instead of suspending the periodic measurement?
+        bool enabled{true};
+        //! Backoff before the first attempt (ms)
+        uint32_t initial_ms{50};
+        //! Upper bound of the backoff (ms)
+        uint32_t max_ms{5000};
+        //! Give up after this number of the attempts in a recovery (0 is unlimited)
+        uint32_t max_attempts{0};
+        //! Reset the bus state of the interface before each attempt?
+        bool bus_recovery{false};
+    };
+
+    /*!
+      @struct counters_t
+      @brief Counters of the recovery
+     */
+    struct counters_t {
+        uint32_t faults{};      //!< Number of the recoveries started
+        uint32_t recoveries{};  //!< Number of the recoveries succeeded
+        uint32_t attempts{};    //!< Number of the attempts
+        uint32_t gave_up{};     //!< Number of the recoveries given up
+    };
+
+    ///@name Settings
+    ///@{
+    /*! @brief Gets the configration */
+    inline config_t config() const
+    {
+        return _cfg;
+    }
+    //! @brief Set the configration
+    inline void config(const config_t& cfg)
+    {
+        _cfg = cfg;
+    }
+    ///@}
+
+    /*!
+      @brief Start the service
+      @param now Current time (ms)
+      @note Counters and the time are reset
+     */
+    void begin(const uint32_t now);
+    //! @brief End the service, the recovery in progress is abandoned
+    void end(const uint32_t now);
+
+    //! @brief The measurement failed, start the recovery
+    void fault(const uint32_t now);
+    //! @brief Is it time to attempt?
+    inline bool due(const uint32_t now) const
+    {
+        return _recovering && (int32_t)(now - _next) >= 0;
+    }
+    /*!
+      @brief The attempt failed
+      @return False if given up
+     */
+    bool failed(const uint32_t now);
+    //! @brief The attempt succeeded
+    void recovered(const uint32_t now);
+
+    ///@name State
+    ///@{
+    //! @brief In recovery?
+    inline bool recovering() const
+    {
+        return _recovering;
+    }
+    //! @brief Time of the next attempt (ms)
+    inline uint32_t next() const
+    {
+        return _next;
+    }
+    //! @brief Current backoff (ms)
+    inline uint32_t backoff() const
+    {
+        return _backoff;
+    }
+    //! @brief Gets the counters
+    inline counters_t counters() const
+    {
+        return _counters;
+    }
+    //! @brief Time in service except in recovery (ms)
+    uint32_t uptime(const uint32_t now) const;
+    //! @brief Time in recovery (ms)
+    uint32_t downtime(const uint32_t now) const;
+    //! @brief Ratio of the uptime to the time in service (0.0 - 1.0), 1.0 if not in service
+    float availability(const uint32_t now) const;
+    ///@}
+
+private:
+    config_t _cfg{};
+    counters_t _counters{};
+    bool _service{}, _recovering{};
+    uint32_t _service_ms{}, _down_ms{};  // Accumulated
+    uint32_t _service_at{}, _down_at{};  // Start of the current period
+    uint32_t _next{}, _backoff{}, _episode_attempts{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
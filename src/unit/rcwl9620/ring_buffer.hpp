@@ -0,0 +1,236 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file ring_buffer.hpp
+  @brief Ring buffer for the measurement data of RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_RING_BUFFER_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_RING_BUFFER_HPP
+
+#include <m5_utility/container/circular_buffer.hpp>  // m5::stl::optional
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+#include <atomic>
+#include <new>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class RingBuffer
+  @brief Ring buffer with bulk access
+  @details Same interface as m5::container::CircularBuffer for the element access,
+  and the contents can be copied or viewed as at most two contiguous segments.
+  The positions are published with acquire/release, so one context can push while another one reads and removes
+  (single producer single consumer) if the buffer is not overwritten
+  @tparam T Element type
+  @note The producer calls push_back() only, the consumer calls the others.
+  If overwrite is true, push_back() removes the oldest when full, so both must be in the same context
+ */
+template <typename T>
+class RingBuffer {
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using const_reference = const T&;
+
+    /*!
+      @struct view_t
+      @brief Contents as contiguous segments, from the oldest
+     */
+    struct view_t {
+        const T* first{};         //!< First (older) segment
+        size_type first_size{};   //!< Number of elements of the first segment
+        const T* second{};        //!< Second segment (nullptr if none)
+        size_type second_size{};  //!< Number of elements of the second segment
+
+        //! @brief Total number of elements
+        inline size_type size() const
+        {
+            return first_size + second_size;
+        }
+    };
+
+    /*!
+      @param cap Capacity
+      @param overwrite Overwrite the oldest if full? If false, push_back() fails when full
+      @note Capacity is 0 if failed to allocate
+     */
+    explicit RingBuffer(const size_type cap, const bool overwrite = true)
+        : _owned{new (std::nothrow) T[cap + 1]}, _buf{_owned.get()}, _slots{_buf ? cap + 1 : 1}, _overwrite{overwrite}
+    {
+    }
+    /*!
+      @brief Using the external storage without allocation
+      @param storage Storage of the elements
+      @param slots Number of elements of the storage (capacity + 1)
+      @param overwrite Overwrite the oldest if full? If false, push_back() fails when full
+      @warning The lifetime of the storage must be longer than the buffer
+     */
+    RingBuffer(T* storage, const size_type slots, const bool overwrite = true)
+        : _buf{storage}, _slots{storage && slots ? slots : 1}, _overwrite{overwrite}
+    {
+    }
+
+    ///@name Capacity
+    ///@{
+    inline bool empty() const
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+    inline bool full() const
+    {
+        return size() == capacity();
+    }
+    //! @brief Number of elements (a snapshot if the other context is running)
+    inline size_type size() const
+    {
+        const size_type h = _head.load(std::memory_order_acquire);
+        const size_type t = _tail.load(std::memory_order_acquire);
+        return t >= h ? t - h : t + _slots - h;
+    }
+    inline size_type capacity() const
+    {
+        return _slots - 1;
+    }
+    //! @brief Is the oldest overwritten if full?
+    inline bool overwrite() const
+    {
+        return _overwrite;
+    }
+    //! @brief Set whether to overwrite the oldest if full
+    inline void overwrite(const bool enable)
+    {
+        _overwrite = enable;
+    }
+    ///@}
+
+    ///@name Element access
+    ///@{
+    //! @brief Oldest element
+    inline m5::stl::optional<T> front() const
+    {
+        const size_type h = _head.load(std::memory_order_relaxed);
+        return h != _tail.load(std::memory_order_acquire) ? m5::stl::optional<T>(_buf[h]) : m5::stl::optional<T>();
+    }
+    //! @brief Latest element
+    inline m5::stl::optional<T> back() const
+    {
+        const size_type t = _tail.load(std::memory_order_acquire);
+        return t != _head.load(std::memory_order_acquire) ? m5::stl::optional<T>(_buf[t ? t - 1 : _slots - 1])
+                                                          : m5::stl::optional<T>();
+    }
+    //! @brief Element from the oldest
+    inline const_reference operator[](const size_type i) const
+    {
+        return _buf[wrap(_head.load(std::memory_order_relaxed) + i)];
+    }
+    ///@}
+
+    ///@name Modifiers
+    ///@{
+    /*!
+      @brief Push the element
+      @return False if full and not overwritten
+     */
+    bool push_back(const T& v)
+    {
+        const size_type t = _tail.load(std::memory_order_relaxed);
+        const size_type n = wrap(t + 1);
+        if (n == _head.load(std::memory_order_acquire)) {
+            if (!_overwrite || _slots == 1) {
+                return false;
+            }
+            _head.store(wrap(n + 1), std::memory_order_release);
+        }
+        _buf[t] = v;
+        _tail.store(n, std::memory_order_release);
+        return true;
+    }
+    //! @brief Remove the oldest element
+    inline void pop_front()
+    {
+        pop_front(1);
+    }
+    //! @brief Remove the oldest elements
+    void pop_front(const size_type n)
+    {
+        const size_type cnt = std::min(n, size());
+        _head.store(wrap(_head.load(std::memory_order_relaxed) + cnt), std::memory_order_release);
+    }
+    inline void clear()
+    {
+        _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    ///@}
+
+    ///@name Bulk access
+    ///@{
+    //! @brief Gets the contents as at most two contiguous segments
+    view_t view() const
+    {
+        const size_type h = _head.load(std::memory_order_relaxed);
+        const size_type t = _tail.load(std::memory_order_acquire);
+        view_t v{};
+        v.first_size  = t >= h ? t - h : _slots - h;
+        v.first       = v.first_size ? _buf + h : nullptr;
+        v.second_size = t >= h ? 0 : t;
+        v.second      = v.second_size ? _buf : nullptr;
+        return v;
+    }
+    /*!
+      @brief Copy the elements from the oldest
+      @param[out] out Output buffer
+      @param max Max number of elements of the output buffer
+      @return Number of elements copied
+     */
+    size_type read(T* out, const size_type max) const
+    {
+        auto v = view();
+        if (!out) {
+            return 0;
+        }
+        const size_type n1 = std::min(max, v.first_size);
+        const size_type n2 = std::min(max - n1, v.second_size);
+        std::copy(v.first, v.first + n1, out);
+        std::copy(v.second, v.second + n2, out + n1);
+        return n1 + n2;
+    }
+    /*!
+      @brief Copy and remove the elements from the oldest
+      @param[out] out Output buffer
+      @param max Max number of elements of the output buffer
+      @return Number of elements removed
+     */
+    size_type drain(T* out, const size_type max)
+    {
+        auto n = read(out, max);
+        pop_front(n);
+        return n;
+    }
+    ///@}
+
+protected:
+    inline size_type wrap(const size_type i) const
+    {
+        return i < _slots ? i : i - _slots;
+    }
+
+private:
+    std::unique_ptr<T[]> _owned{};
+    T* _buf{};
+    const size_type _slots{};  // One slot is kept empty to tell full from empty
+    bool _overwrite{};
+    std::atomic<size_type> _head{0};  // Written by the consumer (and the producer if overwrite)
+    std::atomic<size_type> _tail{0};  // Written by the producer
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file scheduler.cpp
+  @brief Interleaved periodic measurement of multiple RCWL9620
+*/
+#include "scheduler.hpp"
+#include <algorithm>
+
+using namespace m5::unit::types;
+
+namespace {
+// Give up the measurement if it cannot be read within this time from the request (ms)
+constexpr elapsed_time_t read_timeout{1000};
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+bool Scheduler::add(UnitRCWL9620& unit)
+{
+    if (_running) {
+        M5_LIB_LOGE("Scheduler is running");
+        return false;
+    }
+    if (unit._scheduler) {
+        M5_LIB_LOGE("Already scheduled");
+        return false;
+    }
+    if (!unit.idle()) {
+        M5_LIB_LOGE("Measurement of the unit is running");
+        return false;
+    }
+    if (!unit.interface()) {
+        M5_LIB_LOGE("The unit has not begun");
+        return false;
+    }
+    if (!_entries.empty() && &unit.clock() != &_entries.front().unit->clock()) {
+        M5_LIB_LOGE("The clock differs from the other units");
+        return false;
+    }
+    entry_t e{};
+    e.unit          = &unit;
+    unit._scheduler = this;
+    unit.update_due();
+    _entries.push_back(e);
+    return true;
+}
+
+void Scheduler::clear()
+{
+    stop();
+    for (auto&& e : _entries) {
+        e.unit->_scheduler = nullptr;
+        e.unit->update_due();
+    }
+    _entries.clear();
+}
+
+bool Scheduler::start()
+{
+    if (_running || _entries.empty() || !_cfg.concurrency) {
+        return false;
+    }
+
+    uint32_t ranging{};
+    for (auto&& e : _entries) {
+        ranging = std::max(ranging, e.unit->interface()->ranging_time());
+    }
+    // A slot with the ranging time 0 (GPIO) proceeds as soon as the echo is read
+    _slot_ms = std::max(_cfg.slot_ms, ranging);
+    for (auto&& e : _entries) {
+        e.pending         = false;
+        e.unit->_periodic = true;
+        e.unit->_interval = cycleTime();
+        e.unit->_latest   = 0;
+        e.unit->_updated  = false;
+    }
+    _samples = _errors = 0;
+    _started_at        = now();
+    _running           = true;
+
+    M5_LIB_LOGI("Scheduler: %u units, %u groups, slot:%u cycle:%u", (unsigned)_entries.size(), groups(),
+                _slot_ms, cycleTime());
+    _group = groups() - 1;
+    request_group(_started_at);
+    return true;
+}
+
+void Scheduler::stop()
+{
+    if (!_running) {
+        return;
+    }
+    for (auto&& e : _entries) {
+        if (e.pending) {
+            e.unit->interface()->reset();
+            e.pending = false;
+        }
+        e.unit->_periodic = false;
+    }
+    _running = false;
+}
+
+void Scheduler::update()
+{
+    if (!_running) {
+        return;
+    }
+    for (auto&& e : _entries) {
+        e.unit->_updated = false;
+    }
+    auto at = now();
+    if (at - _requested_at < _slot_ms || !read_group()) {
+        return;
+    }
+    request_group(at);
+}
+
+float Scheduler::samplesPerSecond() const
+{
+    if (_entries.empty()) {
+        return 0.0f;
+    }
+    auto elapsed = now() - _started_at;
+    return elapsed ? _samples * 1000.f / elapsed : 0.0f;
+}
+
+// Read the current group, true if all the units of the group have been completed
+bool Scheduler::read_group()
+{
+    bool completed{true};
+    for (auto&& e : _entries) {
+        if (!e.pending) {
+            continue;
+        }
+        auto u = e.unit;
+        Data d{};
+        bool timeouted{};
+        if (u->read_measurement(d, timeouted)) {
+            e.pending = false;
+            // Data is invalid after Timeout has occurred
+            if (!timeouted) {
+                u->store_measurement(d);
+                u->_updated = true;
+                u->_latest  = now();
+                ++_samples;
+            } else {
+                ++_errors;
+            }
+            continue;
+        }
+        if (now() - _requested_at >= read_timeout) {
+            M5_LIB_LOGW("Measurement timed out %02X", u->address());
+            u->interface()->reset();
+            e.pending = false;
+            ++_errors;
+            continue;
+        }
+        completed = false;  // Try again on the next call
+    }
+    return completed;
+}
+
+// Request the next group
+void Scheduler::request_group(const types::elapsed_time_t at)
+{
+    _group = (_group + 1) % groups();
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        if (group(i) != _group) {
+            continue;
+        }
+        auto& e   = _entries[i];
+        e.pending = e.unit->request_measurement();
+        if (!e.pending) {
+            ++_errors;
+        }
+    }
+    _requested_at = at;
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
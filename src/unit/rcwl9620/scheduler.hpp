@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file scheduler.hpp
+  @brief Interleaved periodic measurement of multiple RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_SCHEDULER_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_SCHEDULER_HPP
+
+#include "../unit_RCWL9620.hpp"
+#include <vector>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Scheduler
+  @brief Staggers the periodic measurement of multiple units on a shared bus
+  @details The units are divided into groups of concurrency units, and the groups are requested in turn, one per slot.
+  The measurement of the previous group is read in the slot of the next group,
+  so the bus is used during the ranging time and the pings of different groups do not overlap.
+  Measured data is stored in the periodic measurement data of each unit, and updated() of the unit is set.
+  The time is taken from the clock of the units, so all of them must use the same clock
+  @note Call update() after UnitUnified::update()
+  @warning The lifetime of the units must be longer than the scheduler
+ */
+class Scheduler {
+public:
+    /*!
+      @struct config_t
+      @brief Settings for start
+     */
+    struct config_t {
+        //! Slot time (ms), 0 means the longest ranging time of the units
+        uint32_t slot_ms{};
+        //! Number of units ranging at the same time (1 means no acoustic crosstalk)
+        uint8_t concurrency{1};
+    };
+
+    Scheduler()
+    {
+    }
+    ~Scheduler()
+    {
+        clear();
+    }
+
+    ///@name Settings
+    ///@{
+    /*! @brief Gets the configration */
+    inline config_t config() const
+    {
+        return _cfg;
+    }
+    //! @brief Set the configration
+    inline void config(const config_t& cfg)
+    {
+        _cfg = cfg;
+    }
+    ///@}
+
+    ///@name Units
+    ///@{
+    /*!
+      @brief Add the unit
+      @param unit Unit already begun
+      @return True if successful
+      @warning Periodic measurement of the unit must be stopped (config_t::start_periodic false)
+      @warning The clock of the unit must be the same as the units already added
+      @warning Cannot add while running
+     */
+    bool add(UnitRCWL9620& unit);
+    //! @brief Remove all units
+    void clear();
+    //! @brief Number of units
+    inline size_t size() const
+    {
+        return _entries.size();
+    }
+    //! @brief Gets the unit
+    inline UnitRCWL9620* unit(const size_t idx) const
+    {
+        return idx < _entries.size() ? _entries[idx].unit : nullptr;
+    }
+    ///@}
+
+    ///@name Schedule
+    ///@{
+    /*!
+      @brief Start the measurement of all units
+      @return True if successful
+     */
+    bool start();
+    /*!
+      @brief Stop the measurement of all units
+      @note Outstanding requests are discarded
+     */
+    void stop();
+    //! @brief Is running?
+    inline bool running() const
+    {
+        return _running;
+    }
+    //! @brief Proceed the schedule, call in loop
+    void update();
+
+    //! @brief Slot time (ms)
+    inline uint32_t slotTime() const
+    {
+        return _slot_ms;
+    }
+    //! @brief Number of groups
+    inline uint32_t groups() const
+    {
+        return _cfg.concurrency ? (_entries.size() + _cfg.concurrency - 1) / _cfg.concurrency : 0;
+    }
+    //! @brief Time for all units to be measured once (ms)
+    inline uint32_t cycleTime() const
+    {
+        return _slot_ms * groups();
+    }
+    //! @brief Gets the group of the unit
+    inline uint32_t group(const size_t idx) const
+    {
+        return _cfg.concurrency ? idx / _cfg.concurrency : 0;
+    }
+    //! @brief Gets the offset time in the cycle of the unit (ms)
+    inline uint32_t offset(const size_t idx) const
+    {
+        return group(idx) * _slot_ms;
+    }
+    ///@}
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of valid samples stored
+    inline uint32_t samples() const
+    {
+        return _samples;
+    }
+    //! @brief Number of measurements that failed or timed out
+    inline uint32_t errors() const
+    {
+        return _errors;
+    }
+    //! @brief Aggregate samples per second since start
+    float samplesPerSecond() const;
+    ///@}
+
+protected:
+    struct entry_t {
+        UnitRCWL9620* unit{};
+        bool pending{};
+    };
+
+    bool read_group();
+    void request_group(const types::elapsed_time_t at);
+    // Time of the clock of the units (ms)
+    inline types::elapsed_time_t now() const
+    {
+        return _entries.front().unit->_clock.millis();
+    }
+
+private:
+    std::vector<entry_t> _entries{};
+    config_t _cfg{};
+    uint32_t _slot_ms{};
+    uint32_t _group{};
+    types::elapsed_time_t _requested_at{}, _started_at{};
+    uint32_t _samples{}, _errors{};
+    bool _running{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
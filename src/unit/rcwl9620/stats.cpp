@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file stats.cpp
+  @brief Instrumentation of RCWL9620
+*/
+#include "stats.hpp"
+
+namespace {
+constexpr auto relaxed = std::memory_order_relaxed;
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+// For C++11/14
+constexpr size_t Histogram::BUCKETS;
+
+uint32_t Histogram::percentile(const float p) const
+{
+    if (!count) {
+        return 0;
+    }
+    const uint64_t target = std::max<uint64_t>(1, (uint64_t)(p * count + 0.5f));
+    uint64_t acc{};
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        acc += buckets[i];
+        if (acc >= target) {
+            return (i + 1 < BUCKETS) ? std::min(lower(i + 1) - 1, max) : max;
+        }
+    }
+    return max;
+}
+
+// class StatsRecorder
+void StatsRecorder::read(const uint32_t us, const bool completed, const bool timeouted)
+{
+    _read.add(us);
+    if (!completed) {
+        inc(_not_ready);
+    } else if (timeouted) {
+        inc(_timeouts);
+    } else {
+        inc(_samples);
+    }
+}
+
+Stats StatsRecorder::snapshot() const
+{
+    Stats s{};
+    s.request_us       = _request.snapshot();
+    s.read_us          = _read.snapshot();
+    s.lateness_us      = _lateness.snapshot();
+    s.samples          = _samples.load(relaxed);
+    s.timeouts         = _timeouts.load(relaxed);
+    s.not_ready        = _not_ready.load(relaxed);
+    s.request_failures = _request_failures.load(relaxed);
+    s.overruns         = _overruns.load(relaxed);
+    s.overwritten      = _overwritten.load(relaxed);
+    s.dropped          = _dropped.load(relaxed);
+    s.bus_bytes        = _bus_bytes.load(relaxed);
+    return s;
+}
+
+void StatsRecorder::reset()
+{
+    _request.reset();
+    _read.reset();
+    _lateness.reset();
+    for (auto c : {&_samples, &_timeouts, &_not_ready, &_request_failures, &_overruns, &_overwritten, &_dropped,
+                   &_bus_bytes}) {
+        c->store(0, relaxed);
+    }
+}
+
+void StatsRecorder::histogram_t::add(const uint32_t v)
+{
+    inc(buckets[Histogram::index(v)]);
+    inc(count);
+    if (v < min.load(relaxed)) {
+        min.store(v, relaxed);
+    }
+    if (v > max.load(relaxed)) {
+        max.store(v, relaxed);
+    }
+    // 64-bit atomic is not lock-free on some targets
+    const uint32_t lo = sum_lo.load(relaxed) + v;
+    if (lo < v) {
+        inc(sum_hi);
+    }
+    sum_lo.store(lo, relaxed);
+}
+
+Histogram StatsRecorder::histogram_t::snapshot() const
+{
+    Histogram h{};
+    for (size_t i = 0; i < Histogram::BUCKETS; ++i) {
+        h.buckets[i] = buckets[i].load(relaxed);
+    }
+    h.count = count.load(relaxed);
+    h.min   = h.count ? min.load(relaxed) : 0;
+    h.max   = max.load(relaxed);
+    h.sum   = ((uint64_t)sum_hi.load(relaxed) << 32) | sum_lo.load(relaxed);
+    return h;
+}
+
+void StatsRecorder::histogram_t::reset()
+{
+    for (auto&& b : buckets) {
+        b.store(0, relaxed);
+    }
+    count.store(0, relaxed);
+    min.store(UINT32_MAX, relaxed);
+    max.store(0, relaxed);
+    sum_lo.store(0, relaxed);
+    sum_hi.store(0, relaxed);
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file stats.hpp
+  @brief Instrumentation of RCWL9620
+  @details Recording is compiled in only if M5_UNIT_RCWL9620_ENABLE_STATS is defined as non-zero
+  (e.g. build_flags = -DM5_UNIT_RCWL9620_ENABLE_STATS=1)
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_STATS_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_STATS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <algorithm>
+
+#if !defined(M5_UNIT_RCWL9620_ENABLE_STATS)
+#define M5_UNIT_RCWL9620_ENABLE_STATS 0
+#endif
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @struct Histogram
+  @brief Fixed bucket histogram of the time (us)
+  @details Bucket 0 is 0, bucket i is [2^(i-1), 2^i), and the last bucket includes all the larger
+ */
+struct Histogram {
+    static constexpr size_t BUCKETS{16};
+
+    uint32_t buckets[BUCKETS]{};
+    uint32_t count{};  //!< Number of the values
+    uint32_t min{};    //!< Minimum value, 0 if empty
+    uint32_t max{};    //!< Maximum value
+    uint64_t sum{};    //!< Sum of the values
+
+    //! @brief Index of the bucket for the value
+    inline static size_t index(const uint32_t v)
+    {
+        return v ? std::min<size_t>(BUCKETS - 1, 32 - __builtin_clz(v)) : 0;
+    }
+    //! @brief Lower bound of the bucket
+    inline static constexpr uint32_t lower(const size_t i)
+    {
+        return i ? 1U << (i - 1) : 0;
+    }
+    //! @brief Mean of the values
+    inline float mean() const
+    {
+        return count ? (float)sum / count : 0.0f;
+    }
+    /*!
+      @brief Estimated percentile
+      @param p Percentile (0.0 - 1.0)
+      @return Upper bound of the bucket including the percentile, clipped by the maximum value
+     */
+    uint32_t percentile(const float p) const;
+};
+
+/*!
+  @struct Stats
+  @brief Snapshot of the statistics of the unit
+ */
+struct Stats {
+    Histogram request_us{};       //!< Time to issue the request
+    Histogram read_us{};          //!< Time of the read including the bus transaction or the echo
+    Histogram lateness_us{};      //!< Completion of the read later than the scheduled time (periodic)
+    uint32_t samples{};           //!< Completed reads with the data
+    uint32_t timeouts{};          //!< Completed reads without the data (e.g. deadline exceeded, no echo)
+    uint32_t not_ready{};         //!< Reads tried again later
+    uint32_t request_failures{};  //!< Failed requests
+    uint32_t overruns{};          //!< Reads later than the interval, the period is missed (periodic)
+    uint32_t overwritten{};       //!< Stored samples overwritten by the new one
+    uint32_t dropped{};           //!< New samples dropped (not overwritable storage or the queue of the task)
+    uint32_t bus_bytes{};         //!< Bytes on the bus including the address (I2C)
+
+    //! @brief Average bytes on the bus per sample
+    inline float bytesPerSample() const
+    {
+        return samples ? (float)bus_bytes / samples : 0.0f;
+    }
+};
+
+/*!
+  @class StatsRecorder
+  @brief Records the statistics
+  @details Single writer, the measurement may be recorded in the background task and
+  snapshot() read in the other. Each value is consistent but the snapshot is not atomic as a whole
+  @note dropped() is the exception, recorded by both the task (queue) and update() (storage)
+  @note reset() while the task is running may lose the reset of some values
+ */
+class StatsRecorder {
+public:
+    StatsRecorder()
+    {
+        reset();
+    }
+
+    //! @brief The request is issued
+    inline void request(const uint32_t us, const bool ok)
+    {
+        _request.add(us);
+        if (!ok) {
+            inc(_request_failures);
+        }
+    }
+    //! @brief The read is done
+    void read(const uint32_t us, const bool completed, const bool timeouted);
+    /*!
+      @brief The read of the periodic measurement is completed
+      @param late_us Time from the scheduled time
+      @param interval_us Interval of the measurement
+     */
+    inline void lateness(const uint32_t late_us, const uint32_t interval_us)
+    {
+        _lateness.add(late_us);
+        if (late_us >= interval_us) {
+            inc(_overruns);
+        }
+    }
+    //! @brief The stored sample is overwritten
+    inline void overwritten()
+    {
+        inc(_overwritten);
+    }
+    //! @brief The new sample is dropped
+    inline void dropped()
+    {
+        // Multiple writers
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    //! @brief Bytes on the bus
+    inline void bus(const uint32_t bytes)
+    {
+        inc(_bus_bytes, bytes);
+    }
+
+    //! @brief Gets the snapshot
+    Stats snapshot() const;
+    //! @brief Reset all the values
+    void reset();
+
+private:
+    using counter_t = std::atomic<uint32_t>;
+    // Only the single writer, so RMW is not needed
+    inline static void inc(counter_t& c, const uint32_t v = 1)
+    {
+        c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+    struct histogram_t {
+        counter_t buckets[Histogram::BUCKETS];
+        counter_t count, min, max;
+        counter_t sum_lo, sum_hi;
+        void add(const uint32_t v);
+        Histogram snapshot() const;
+        void reset();
+    };
+
+    histogram_t _request, _read, _lateness;
+    counter_t _samples, _timeouts, _not_ready, _request_failures, _overruns;
+    counter_t _overwritten, _dropped, _bus_bytes;
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,241 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file telemetry.cpp
+  @brief Compact binary telemetry of RCWL9620
+*/
+#include "telemetry.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+// CRC-16/CCITT-FALSE by the nibble
+constexpr uint16_t crc_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+constexpr uint32_t RAW_MASK{0x00FFFFFF};
+
+inline uint32_t zigzag(const int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+inline int32_t unzigzag(const uint32_t v)
+{
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+inline size_t put_varint(uint8_t* p, uint32_t v)
+{
+    size_t n{};
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+// False if not terminated within the max bytes
+inline bool get_varint(const uint8_t*& p, const uint8_t* end, uint32_t& v, const size_t max_bytes)
+{
+    v = 0;
+    for (uint32_t shift = 0; shift < 7 * max_bytes && p < end; shift += 7) {
+        const uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void put_u16(uint8_t* p, const uint16_t v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+inline void put_u32(uint8_t* p, const uint32_t v)
+{
+    put_u16(p, v);
+    put_u16(p + 2, v >> 16);
+}
+
+inline uint16_t get_u16(const uint8_t* p)
+{
+    return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+inline uint32_t get_u32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+namespace telemetry {
+
+uint16_t crc16(const uint8_t* p, const size_t len, const uint16_t crc)
+{
+    uint16_t c{crc};
+    for (size_t i = 0; i < len; ++i) {
+        c = (c << 4) ^ crc_table[(c >> 12) ^ (p[i] >> 4)];
+        c = (c << 4) ^ crc_table[(c >> 12) ^ (p[i] & 0x0F)];
+    }
+    return c;
+}
+
+// class Encoder
+bool Encoder::begin(const header_t& h)
+{
+    if (!_buf || _size < max_frame_size(1)) {
+        return false;
+    }
+    _buf[0] = SYNC0;
+    _buf[1] = SYNC1;
+    _buf[2] = VERSION;
+    _buf[3] = h.unit_id;
+    put_u32(_buf + 5, h.timestamp_ms);
+    put_u16(_buf + 9, h.interval_ms);
+    _pos         = HEADER_SIZE;
+    _count       = 0;
+    _prev        = 0;
+    _expected_ms = h.timestamp_ms;
+    _interval_ms = h.interval_ms;
+    return true;
+}
+
+bool Encoder::push(const uint32_t um, const uint32_t ms)
+{
+    if (!_pos || full()) {
+        return false;
+    }
+    const uint32_t v = um & RAW_MASK;
+    _pos += put_varint(_buf + _pos, _count ? zigzag((int32_t)(v - _prev)) : v);
+    _pos += put_varint(_buf + _pos, zigzag((int32_t)(ms - _expected_ms)));
+    _prev        = v;
+    _expected_ms = ms + _interval_ms;
+    ++_count;
+    return true;
+}
+
+size_t Encoder::finish()
+{
+    if (!_pos || !_count) {
+        return 0;
+    }
+    _buf[4] = _count;
+    put_u16(_buf + 11, _pos - HEADER_SIZE);
+    put_u16(_buf + _pos, crc16(_buf + 2, _pos - 2));
+    const size_t len = _pos + CRC_SIZE;
+    _pos = _count = 0;
+    return len;
+}
+
+// class Decoder
+size_t Decoder::feed(const uint8_t* p, size_t len)
+{
+    size_t frames{};
+    while (len) {
+        const size_t n = std::min(len, sizeof(_buf) - _len);
+        std::memcpy(_buf + _len, p, n);
+        _len += n;
+        p += n;
+        len -= n;
+        while (_len && process(frames)) {
+        }
+    }
+    return frames;
+}
+
+bool Decoder::process(size_t& frames)
+{
+    // Sync
+    const uint8_t* s = static_cast<const uint8_t*>(std::memchr(_buf, SYNC0, _len));
+    if (s != _buf) {
+        const size_t skip = s ? s - _buf : _len;
+        _counters.skipped += skip;
+        drop(skip);
+        return _len != 0;
+    }
+    if (_len < 2) {
+        return false;
+    }
+    if (_buf[1] != SYNC1) {
+        ++_counters.skipped;
+        drop(1);
+        return true;
+    }
+    // Header
+    if (_len < HEADER_SIZE) {
+        return false;
+    }
+    const uint8_t count       = _buf[4];
+    const size_t payload_size = get_u16(_buf + 11);
+    if (_buf[2] != VERSION || !count || payload_size < 2 * count || payload_size > MAX_SAMPLE_SIZE * count) {
+        ++_counters.malformed;
+        drop(1);
+        return true;
+    }
+    const size_t frame_size = HEADER_SIZE + payload_size + CRC_SIZE;
+    if (_len < frame_size) {
+        return false;
+    }
+    if (crc16(_buf + 2, HEADER_SIZE - 2 + payload_size) != get_u16(_buf + HEADER_SIZE + payload_size)) {
+        ++_counters.crc_errors;
+        drop(1);
+        return true;
+    }
+    // Payload
+    header_t h{};
+    h.unit_id      = _buf[3];
+    h.count        = count;
+    h.timestamp_ms = get_u32(_buf + 5);
+    h.interval_ms  = get_u16(_buf + 9);
+
+    const uint8_t* p   = _buf + HEADER_SIZE;
+    const uint8_t* end = p + payload_size;
+    uint32_t v{}, dt{}, prev{}, expected{h.timestamp_ms};
+    for (size_t i = 0; i < count; ++i) {
+        if (!get_varint(p, end, v, MAX_DISTANCE_SIZE) || !get_varint(p, end, dt, MAX_TIME_SIZE)) {
+            break;
+        }
+        prev     = (i ? prev + unzigzag(v) : v) & RAW_MASK;
+        _um[i]   = prev;
+        _ms[i]   = expected + unzigzag(dt);
+        expected = _ms[i] + h.interval_ms;
+        if (i + 1 == count && p == end) {
+            ++_counters.frames;
+            _counters.samples += count;
+            ++frames;
+            if (_callback) {
+                _callback(h, _um, _ms, count);
+            }
+            drop(frame_size);
+            return true;
+        }
+    }
+    ++_counters.malformed;
+    drop(1);
+    return true;
+}
+
+void Decoder::drop(const size_t n)
+{
+    std::memmove(_buf, _buf + n, _len - n);
+    _len -= n;
+}
+
+}  // namespace telemetry
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file telemetry.hpp
+  @brief Compact binary telemetry of RCWL9620
+  @details Frame (little endian)
+  | Offset | Size | Field |
+  |---|---|---|
+  | 0 | 2 | Sync 0xA5 0x5A |
+  | 2 | 1 | Version |
+  | 3 | 1 | Unit id |
+  | 4 | 1 | Number of samples (1 - 255) |
+  | 5 | 4 | Timestamp of the first sample (ms) |
+  | 9 | 2 | Nominal interval of the samples (ms) |
+  | 11 | 2 | Length of the payload |
+  | 13 | n | Payload |
+  | 13 + n | 2 | CRC-16/CCITT-FALSE from the version to the end of the payload |
+
+  The payload is the samples in order, each of
+  - Raw distance (um), as varint (LEB128) for the first sample and
+    as zigzag varint of the difference from the previous sample for the others
+  - Time (ms) as zigzag varint of the difference from the expected time,
+    which is the timestamp for the first sample and the previous time + interval for the others
+
+  So the samples on time cost 1 byte for the time, and the dropped or late samples keep their own time
+  @note Not depending on M5Utility and M5UnitUnified, so it can be built for the host
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_TELEMETRY_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_TELEMETRY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+namespace telemetry {
+
+///@name Frame
+///@{
+constexpr uint8_t SYNC0{0xA5};
+constexpr uint8_t SYNC1{0x5A};
+constexpr uint8_t VERSION{2};
+constexpr size_t HEADER_SIZE{13};
+constexpr size_t CRC_SIZE{2};
+constexpr size_t MAX_SAMPLES{255};
+//! @brief Maximum bytes of the distance in the payload (24-bit value or 25-bit zigzag difference)
+constexpr size_t MAX_DISTANCE_SIZE{4};
+//! @brief Maximum bytes of the time in the payload (32-bit zigzag difference)
+constexpr size_t MAX_TIME_SIZE{5};
+//! @brief Maximum bytes of the sample in the payload
+constexpr size_t MAX_SAMPLE_SIZE{MAX_DISTANCE_SIZE + MAX_TIME_SIZE};
+
+//! @brief Size of the frame for the samples in the worst case
+constexpr size_t max_frame_size(const size_t samples)
+{
+    return HEADER_SIZE + MAX_SAMPLE_SIZE * samples + CRC_SIZE;
+}
+///@}
+
+/*!
+  @struct header_t
+  @brief Header of the frame
+ */
+struct header_t {
+    uint8_t unit_id{};        //!< Identifier of the unit (user defined)
+    uint8_t count{};          //!< Number of the samples, set by the encoder
+    uint32_t timestamp_ms{};  //!< Time of the first sample
+    uint16_t interval_ms{};   //!< Nominal interval of the samples, each sample has its own time
+};
+
+//! @brief CRC-16/CCITT-FALSE
+uint16_t crc16(const uint8_t* p, const size_t len, const uint16_t crc = 0xFFFF);
+
+/*!
+  @class Encoder
+  @brief Encodes the samples into the frame on the buffer
+ */
+class Encoder {
+public:
+    /*!
+      @param buf Buffer of the frame
+      @param size Size of the buffer, max_frame_size() of the samples to be pushed is safe
+      @warning The lifetime of the buffer must be longer than the encoder
+     */
+    Encoder(uint8_t* buf, const size_t size) : _buf{buf}, _size{size}
+    {
+    }
+
+    /*!
+      @brief Start the frame
+      @return True if successful
+     */
+    bool begin(const header_t& h);
+    /*!
+      @brief Push the sample
+      @param um Raw distance (um), lower 24 bits are used
+      @param ms Time of the sample (ms)
+      @return False if the frame is full
+     */
+    bool push(const uint32_t um, const uint32_t ms);
+    /*!
+      @brief Push the sample on time
+      @param um Raw distance (um), lower 24 bits are used
+      @return False if the frame is full
+      @note The time is the timestamp for the first sample, the previous time + interval for the others
+     */
+    inline bool push(const uint32_t um)
+    {
+        return push(um, _expected_ms);
+    }
+    /*!
+      @brief Finish the frame
+      @return Size of the frame, 0 if no samples
+      @note begin() is required for the next frame
+     */
+    size_t finish();
+
+    //! @brief Number of the samples in the frame
+    inline size_t count() const
+    {
+        return _count;
+    }
+    //! @brief Is the frame full?
+    inline bool full() const
+    {
+        return _count >= MAX_SAMPLES || _pos + MAX_SAMPLE_SIZE + CRC_SIZE > _size;
+    }
+
+private:
+    uint8_t* _buf{};
+    size_t _size{}, _pos{}, _count{};
+    uint32_t _prev{}, _expected_ms{};
+    uint16_t _interval_ms{};
+};
+
+///@cond 0
+inline uint32_t raw_um(const uint32_t um)
+{
+    return um;
+}
+template <typename T>
+inline auto raw_um(const T& d) -> decltype(d.raw_distance())
+{
+    return d.raw_distance();
+}
+///@endcond
+
+/*!
+  @brief Encode the samples into the frame
+  @tparam T rcwl9620::Data or uint32_t (raw distance in um)
+  @param[out] buf Buffer of the frame
+  @param size Size of the buffer
+  @param h Header, count is ignored
+  @param samples Samples
+  @param n Number of the samples
+  @param ms Times of the samples (ms), nullptr if all the samples are on time
+  @return Size of the frame, 0 if failed or the samples do not fit
+ */
+template <typename T>
+size_t encode(uint8_t* buf, const size_t size, const header_t& h, const T* samples, const size_t n,
+              const uint32_t* ms = nullptr)
+{
+    Encoder enc(buf, size);
+    if (!n || !enc.begin(h)) {
+        return 0;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!(ms ? enc.push(raw_um(samples[i]), ms[i]) : enc.push(raw_um(samples[i])))) {
+            return 0;
+        }
+    }
+    return enc.finish();
+}
+
+/*!
+  @class Decoder
+  @brief Decodes the frames from the byte stream
+  @details Bytes not in the frame are skipped, and the frame with the wrong CRC is discarded
+  with resynchronization
+ */
+class Decoder {
+public:
+    /*!
+      @brief Called on each frame
+      @param h Header
+      @param um Raw distances (um)
+      @param ms Times of the samples (ms)
+      @param n Number of the samples
+     */
+    using callback_t = std::function<void(const header_t& h, const uint32_t* um, const uint32_t* ms, const size_t n)>;
+
+    /*!
+      @struct counters_t
+      @brief Counters of the decoder
+     */
+    struct counters_t {
+        uint32_t frames{};      //!< Decoded frames
+        uint32_t samples{};     //!< Decoded samples
+        uint32_t crc_errors{};  //!< Frames with the wrong CRC
+        uint32_t malformed{};   //!< Frames with the wrong header or payload
+        uint32_t skipped{};     //!< Bytes skipped to find the sync
+    };
+
+    explicit Decoder(callback_t cb) : _callback{cb}
+    {
+    }
+
+    /*!
+      @brief Feed the received bytes
+      @return Number of the frames decoded
+     */
+    size_t feed(const uint8_t* p, size_t len);
+    //! @brief Discard the bytes of the incomplete frame
+    inline void reset()
+    {
+        _len = 0;
+    }
+
+    //! @brief Gets the counters
+    inline const counters_t& counters() const
+    {
+        return _counters;
+    }
+
+protected:
+    // Decode the frame at the head of the buffer, false if the frame is not complete yet
+    bool process(size_t& frames);
+    void drop(const size_t n);
+
+private:
+    callback_t _callback{};
+    counters_t _counters{};
+    uint8_t _buf[max_frame_size(MAX_SAMPLES)]{};
+    size_t _len{};
+    uint32_t _um[MAX_SAMPLES]{};
+    uint32_t _ms[MAX_SAMPLES]{};
+};
+
+}  // namespace telemetry
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file worker.cpp
+  @brief Background task for RCWL9620
+*/
+#include "worker.hpp"
+#include <M5Utility.hpp>
+#include <algorithm>
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace {
+// Waits are divided by this to respond to stop (ms)
+constexpr uint32_t wait_slice_ms{10};
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+bool Worker::start(function_t func, const config_t& cfg)
+{
+    if (running() || !func) {
+        return false;
+    }
+#if !defined(ESP_PLATFORM)
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+#endif
+    _func = func;
+    _stop.store(false, std::memory_order_release);
+    _running.store(true, std::memory_order_release);
+
+#if defined(ESP_PLATFORM)
+    if (xTaskCreatePinnedToCore(task, "rcwl9620", cfg.stack_size, this, cfg.priority, nullptr,
+                                cfg.core < 0 ? tskNO_AFFINITY : cfg.core) != pdPASS) {
+        M5_LIB_LOGE("Failed to create the task");
+        _running.store(false, std::memory_order_release);
+        return false;
+    }
+#else
+    (void)cfg;
+    _thread = std::thread([this]() { run(); });
+#endif
+    return true;
+}
+
+void Worker::stop()
+{
+    _stop.store(true, std::memory_order_release);
+#if defined(ESP_PLATFORM)
+    while (running()) {
+        m5::utility::delay(1);
+    }
+#else
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+#endif
+}
+
+void Worker::run()
+{
+    while (!_stop.load(std::memory_order_acquire)) {
+        uint32_t wait_ms{};
+        if (!_func(wait_ms)) {
+            break;
+        }
+        if (!wait_ms) {
+#if defined(ESP_PLATFORM)
+            taskYIELD();
+#else
+            std::this_thread::yield();
+#endif
+        }
+        while (wait_ms && !_stop.load(std::memory_order_acquire)) {
+            const uint32_t ms = std::min(wait_ms, wait_slice_ms);
+            m5::utility::delay(ms);
+            wait_ms -= ms;
+        }
+    }
+    _running.store(false, std::memory_order_release);
+}
+
+#if defined(ESP_PLATFORM)
+void Worker::task(void* arg)
+{
+    static_cast<Worker*>(arg)->run();
+    vTaskDelete(nullptr);
+}
+#endif
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
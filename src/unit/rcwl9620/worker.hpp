@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file worker.hpp
+  @brief Background task for RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_WORKER_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_WORKER_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#if !defined(ESP_PLATFORM)
+#include <thread>
+#endif
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Worker
+  @brief Calls the function repeatedly in the dedicated task
+  @details FreeRTOS task on ESP32 (pinnable to the core), std::thread on others (e.g. native test)
+ */
+class Worker {
+public:
+    /*!
+      @brief Function called repeatedly
+      @param[out] wait_ms Time to wait before the next call (ms)
+      @return False to finish the task
+     */
+    using function_t = std::function<bool(uint32_t& wait_ms)>;
+
+    /*!
+      @struct config_t
+      @brief Settings of the task
+     */
+    struct config_t {
+        //! Core to run on (-1 is no affinity), ignored if not FreeRTOS
+        int8_t core{-1};
+        //! Priority of the task, ignored if not FreeRTOS
+        uint8_t priority{2};
+        //! Stack size of the task (bytes), ignored if not FreeRTOS
+        uint32_t stack_size{4096};
+    };
+
+    Worker()
+    {
+    }
+    ~Worker()
+    {
+        stop();
+    }
+    Worker(const Worker&)            = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    /*!
+      @brief Start the task
+      @param func Function called in the task
+      @param cfg Settings of the task
+      @return True if successful
+     */
+    bool start(function_t func, const config_t& cfg);
+    //! @brief Start the task with the default settings
+    inline bool start(function_t func)
+    {
+        return start(func, config_t{});
+    }
+    //! @brief Stop the task and wait for its end
+    void stop();
+    //! @brief Is the task running?
+    inline bool running() const
+    {
+        return _running.load(std::memory_order_acquire);
+    }
+
+protected:
+    void run();
+#if defined(ESP_PLATFORM)
+    static void task(void* arg);
+#endif
+
+private:
+    function_t _func{};
+    std::atomic<bool> _running{false}, _stop{false};
+#if !defined(ESP_PLATFORM)
+    std::thread _thread{};
+#endif
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file zones.cpp
+  @brief Zone detection of the distance for RCWL9620
+*/
+#include "zones.hpp"
+#include <M5Utility.hpp>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+// For C++11/14
+constexpr uint8_t Zones::MAX_ZONES;
+
+int8_t Zones::add(const zone_t& z, callback_t cb)
+{
+    if (_size >= MAX_ZONES) {
+        M5_LIB_LOGE("Zones are full");
+        return -1;
+    }
+    if (z.near_um > z.far_um) {
+        M5_LIB_LOGE("Invalid zone %u - %u", z.near_um, z.far_um);
+        return -1;
+    }
+    _zones[_size]     = z;
+    _callbacks[_size] = cb;
+    return _size++;
+}
+
+void Zones::clear()
+{
+    for (uint8_t i = 0; i < _size; ++i) {
+        _callbacks[i] = nullptr;
+    }
+    _size = 0;
+    reset();
+}
+
+void Zones::reset()
+{
+    _inside = _entered = _left = 0;
+}
+
+void Zones::update(const uint32_t um)
+{
+    uint8_t inside{};
+    for (uint8_t i = 0; i < _size; ++i) {
+        const auto& z = _zones[i];
+        if (_inside & (1U << i)) {
+            // Widened by the hysteresis while inside
+            const uint32_t near_um = z.near_um > z.hysteresis_um ? z.near_um - z.hysteresis_um : 0;
+            const uint32_t far_um  = z.far_um + z.hysteresis_um;
+            inside |= (um >= near_um && um <= far_um) ? (1U << i) : 0;
+        } else {
+            inside |= (um >= z.near_um && um <= z.far_um) ? (1U << i) : 0;
+        }
+    }
+    const uint8_t changed = inside ^ _inside;
+    const uint8_t entered = changed & inside;
+    const uint8_t left    = changed & _inside;
+    _inside               = inside;
+    _entered |= entered;
+    _left |= left;
+
+    for (uint8_t i = 0; changed >> i; ++i) {
+        if ((changed & (1U << i)) && _callbacks[i]) {
+            _callbacks[i](i, entered & (1U << i), um);
+        }
+    }
+}
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file zones.hpp
+  @brief Zone detection of the distance for RCWL9620
+*/
+#ifndef M5_UNIT_DISTANCE_RCWL9620_ZONES_HPP
+#define M5_UNIT_DISTANCE_RCWL9620_ZONES_HPP
+
+#include <cstdint>
+#include <array>
+#include <functional>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+/*!
+  @class Zones
+  @brief Detects entering and leaving the distance zones with hysteresis
+  @details Up to MAX_ZONES zones are evaluated on each sample, and transitions are notified
+  by the callback and the event flags (bit n is the zone n)
+ */
+class Zones {
+public:
+    //! @brief Maximum number of the zones
+    static constexpr uint8_t MAX_ZONES{8};
+
+    /*!
+      @struct zone_t
+      @brief Zone of the distance
+      @details Entered if near_um <= distance <= far_um, and left if out of the range widened by hysteresis_um
+      @note Threshold "closer than X" is {0, X}
+     */
+    struct zone_t {
+        uint32_t near_um{0};        //!< Near end (um)
+        uint32_t far_um{0};         //!< Far end (um)
+        uint32_t hysteresis_um{0};  //!< Hysteresis (um)
+    };
+
+    /*!
+      @brief Callback on the transition
+      @param index Index of the zone
+      @param entered True if entered, false if left
+      @param um Distance of the sample (um)
+     */
+    using callback_t = std::function<void(const uint8_t index, const bool entered, const uint32_t um)>;
+
+    ///@name Zones
+    ///@{
+    /*!
+      @brief Add the zone
+      @param z Zone
+      @param cb Callback on the transition (optional)
+      @return Index of the zone, negative if failed (full or invalid)
+     */
+    int8_t add(const zone_t& z, callback_t cb = nullptr);
+    //! @brief Remove all zones
+    void clear();
+    //! @brief Number of the zones
+    inline uint8_t size() const
+    {
+        return _size;
+    }
+    ///@}
+
+    //! @brief Forget the state, the next sample is regarded as the first
+    void reset();
+    /*!
+      @brief Evaluate the zones by the sample
+      @param um Distance (um)
+      @note The zone that the first sample is in is regarded as entered
+     */
+    void update(const uint32_t um);
+
+    ///@name State
+    ///@{
+    //! @brief Is the latest sample in the zone?
+    inline bool inside(const uint8_t index) const
+    {
+        return _inside & (1U << index);
+    }
+    //! @brief Zones that the latest sample is in
+    inline uint8_t insideMask() const
+    {
+        return _inside;
+    }
+    //! @brief Zones entered since the last take
+    inline uint8_t entered() const
+    {
+        return _entered;
+    }
+    //! @brief Zones left since the last take
+    inline uint8_t left() const
+    {
+        return _left;
+    }
+    //! @brief Gets and clears the zones entered since the last take
+    inline uint8_t takeEntered()
+    {
+        const uint8_t v = _entered;
+        _entered        = 0;
+        return v;
+    }
+    //! @brief Gets and clears the zones left since the last take
+    inline uint8_t takeLeft()
+    {
+        const uint8_t v = _left;
+        _left           = 0;
+        return v;
+    }
+    ///@}
+
+private:
+    std::array<zone_t, MAX_ZONES> _zones{};
+    std::array<callback_t, MAX_ZONES> _callbacks{};
+    uint8_t _size{}, _inside{}, _entered{}, _left{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
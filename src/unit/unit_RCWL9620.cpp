@@ -8,95 +8,64 @@
   @brief RCWL9620 Unit for M5UnitUnified
 */
 #include "unit_RCWL9620.hpp"
+#include "rcwl9620/interface.hpp"
 #include <M5Utility.hpp>
+#include <algorithm>
 
 using namespace m5::utility::mmh3;
 using namespace m5::unit::types;
 using namespace m5::unit::rcwl9620;
-using namespace m5::unit::rcwl9620::command;
 
 namespace {
-}  // namespace
+// Give up the single shot measurement if it cannot be read within this time (ms)
+constexpr elapsed_time_t singleshot_timeout{1000};
 
-namespace m5 {
-namespace unit {
-
-// Class that abstracts the interaction between classes and adapters
-// For I2C
-class InterfaceI2C : public UnitRCWL9620::Interface {
-public:
-    explicit InterfaceI2C(UnitRCWL9620& u) : UnitRCWL9620::Interface(u)
-    {
-    }
-    virtual ~InterfaceI2C()
-    {
-    }
-    virtual bool read_measurement(Data& d, bool& timeouted) override
-    {
-        timeouted = false;
-        std::fill(d.raw.begin(), d.raw.end(), 0x00);
-        uint32_t cnt{4};
-        do {
-            if (_unit.readWithTransaction(d.raw.data(), d.raw.size()) == m5::hal::error::error_t::OK) {
-                _requested = false;
-                return true;
-            }
-            timeouted = true;
-        } while (cnt--);
-        return false;
-    }
-    inline virtual bool request_measurement() override
-    {
-        if (!_requested) {
-            _requested = _unit.writeRegister(MEASURE_DISTANCE, nullptr, 0);
+// Allocate the ring buffer unless it has the capacity
+template <typename T>
+bool prepare_ring(std::unique_ptr<RingBuffer<T>>& rb, const size_t cap, const bool overwrite = true)
+{
+    if (!rb || rb->capacity() != cap) {
+        rb.reset(new (std::nothrow) RingBuffer<T>(cap, overwrite));
+        // Capacity is 0 if failed to allocate the storage
+        if (!rb || rb->capacity() != cap) {
+            M5_LIB_LOGE("Failed to allocate");
+            rb.reset();
+            return false;
         }
-        return _requested;
     }
-    bool _requested{};
-};
+    rb->overwrite(overwrite);
+    return true;
+}
 
-// For GPIO
-class InterfaceGPIO : public UnitRCWL9620::Interface {
-public:
-    explicit InterfaceGPIO(UnitRCWL9620& u) : UnitRCWL9620::Interface(u)
-    {
-        _unit.pinModeRX(gpio::Mode::Input);
-        _unit.pinModeTX(gpio::Mode::Output);
-        _unit.writeDigitalTX(false);
-    }
-    virtual ~InterfaceGPIO()
-    {
+// Allocate the feature if enabled, or release it
+template <typename T>
+bool prepare_feature(std::unique_ptr<T>& f, const bool enabled, const typename T::config_t& cfg)
+{
+    if (!enabled) {
+        f.reset();
+        return true;
     }
-    virtual bool read_measurement(Data& d, bool& timeouted) override
-    {
-        std::fill(d.raw.begin(), d.raw.end(), 0x00);
-
-        // Request
-        _unit.writeDigitalTX(LOW);
-        m5::utility::delayMicroseconds(2);
-        _unit.writeDigitalTX(HIGH);
-        m5::utility::delayMicroseconds(10);
-        _unit.writeDigitalTX(LOW);
-
-        // Read
-        uint32_t duration{};
-        if (!_unit.pulseInRX(duration, HIGH, 50000)) {
+    if (!f) {
+        f.reset(new (std::nothrow) T());
+        if (!f) {
+            M5_LIB_LOGE("Failed to allocate");
             return false;
         }
-
-        const uint32_t distance_mm = static_cast<uint32_t>(duration * 0.343f / 2.0f);
-        const uint32_t distance_um = static_cast<uint32_t>(distance_mm * 1000.0f);
-        d.raw[0]                   = (distance_um >> 16) & 0xFF;
-        d.raw[1]                   = (distance_um >> 8) & 0xFF;
-        d.raw[2]                   = distance_um & 0xFF;
-        return true;
     }
-    virtual bool request_measurement() override
-    {
-        // Ignored because request and read are not separated by GPIO
-        return true;
-    }
-};
+    f->config(cfg);
+    return true;
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+// For C++11/14
+constexpr uint32_t Data::MAX_DISTANCE_UM;
+constexpr uint32_t Data::MIN_DISTANCE_UM;
+constexpr uint8_t FilteredData::OUTLIER;
+}  // namespace rcwl9620
 
 // class UnitRCWL9620
 const char UnitRCWL9620::name[] = "UnitRCWL9620";
@@ -107,57 +76,128 @@ bool UnitRCWL9620::begin()
 {
     auto ssize = stored_size();
     assert(ssize && "stored_size must be greater than zero");
-    if (ssize != _data->capacity()) {
-        _data.reset(new m5::container::CircularBuffer<Data>(ssize));
-        if (!_data) {
-            M5_LIB_LOGE("Failed to allocate");
+    if (_data_owned || !_data) {
+        const bool ret = prepare_ring(_data_owned, ssize, !_cfg.lock_free);
+        _data          = _data_owned.get();
+        if (!ret) {
+            return false;
+        }
+    } else if (ssize != _data->capacity()) {
+        M5_LIB_LOGE("stored_size is fixed to %zu", _data->capacity());
+        return false;
+    }
+    _data->overwrite(!_cfg.lock_free);
+    if (_cfg.timestamp) {
+        if (!prepare_ring(_timestamps, ssize)) {
+            return false;
+        }
+    } else {
+        _timestamps.reset();
+    }
+    _max_range_um = Data::clamp_um(_cfg.max_range_mm * 1000U);
+    // The parallel rings are overwritten and indexed by the size of the data, not shareable with the consumer
+    if (_cfg.lock_free && (_cfg.timestamp || Filter::enabled(_cfg.filter))) {
+        M5_LIB_LOGE("Timestamp and filter are not available if lock-free");
+        return false;
+    }
+    if (!prepare_feature(_filter, Filter::enabled(_cfg.filter), _cfg.filter) ||
+        !prepare_feature(_motion, Motion::enabled(_cfg.motion), _cfg.motion) ||
+        !prepare_feature(_adaptive, _cfg.adaptive_interval, _cfg.adaptive) ||
+        !prepare_feature(_recovery, _cfg.recovery.enabled, _cfg.recovery)) {
+        return false;
+    }
+    if (_filter) {
+        if (!prepare_ring(_filtered, ssize)) {
             return false;
         }
+    } else {
+        _filtered.reset();
+    }
+
+    // Destruct first since the new one may be constructed in the same storage
+    _interface.reset();
+    _interface.reset(create_interface(adapter()->type()));
+    if (!_interface) {
+        M5_LIB_LOGE("Invalid adapter %u", adapter()->type());
+        return false;
     }
+    _singleshot = false;
+    _burst_out  = nullptr;
+    _draining   = false;
+    _dropped.store(0, std::memory_order_relaxed);
+    update_due();
 
+    return _cfg.start_periodic ? startPeriodicMeasurement(_cfg.interval_ms) : true;
+}
+
+UnitRCWL9620::Interface* UnitRCWL9620::create_interface(const Adapter::Type type)
+{
     // Check adapter type
-    auto atype = adapter()->type();
-    switch (atype) {
+    switch (type) {
         case Adapter::Type::I2C:
-            _interface.reset(new InterfaceI2C(*this));
-            break;
+            return make_interface<InterfaceI2C>(*this);
         case Adapter::Type::GPIO:
-            _interface.reset(new InterfaceGPIO(*this));
-            break;
+            return make_interface<InterfaceGPIO>(*this, _capture);
         default:
             break;
     }
-    if (!_interface) {
-        M5_LIB_LOGE("Invalid adapter %u", atype);
-        return false;
-    }
-
-    return _cfg.start_periodic ? startPeriodicMeasurement(_cfg.interval_ms) : true;
+    return nullptr;
 }
 
 void UnitRCWL9620::update(const bool force)
 {
     _updated = false;
-    if (inPeriodic()) {
-        elapsed_time_t at{m5::utility::millis()};
+    // Nothing to do until due
+    if (!force && _clock.millis() < _due) {
+        return;
+    }
+    if (_singleshot && _singleshot_callback && singleshotReady()) {
+        Data d{};
+        complete_singleshot(d);
+    }
+    if (inBurst() && _burst_callback) {
+        pollBurst();
+    }
+    if (_draining) {
+        drain_periodic();
+    }
+    if (_background) {
+        drain_background();
+        if (_bg->failed.load(std::memory_order_acquire)) {
+            _bg->worker.stop();
+            _background = false;
+            _bg_resume  = true;
+            fault_periodic();
+        }
+    } else if (recovering()) {
+        recover_periodic();
+    } else if (inPeriodic() && !_scheduler) {
+        // Measurement is proceeded by the scheduler if scheduled
+        elapsed_time_t at{_clock.millis()};
         if (force || !_latest || at >= _latest + _interval) {
             bool timeouted{};
             Data d{};
             _updated = read_measurement(d, timeouted);
+            if (_updated) {
+                record_lateness(_latest + _interval);
+            }
+            if (_adaptive) {
+                adapt_interval(_updated, timeouted);
+            }
             if (_updated) {
                 // Data is invalid after Timeout has occurred
                 if (!timeouted) {
-                    _data->push_back(d);
+                    store_measurement(d);
                 }
-                if (!request_measurement()) {
-                    _periodic = false;
-                    M5_LIB_LOGE("Periodic measurements have been suspended");
-                    return;
+                if (request_measurement()) {
+                    _latest = _clock.millis();
+                } else {
+                    fault_periodic();
                 }
-                _latest = m5::utility::millis();
             }
         }
     }
+    update_due();
 }
 
 bool UnitRCWL9620::measureSingleshot(rcwl9620::Data& d)
@@ -167,18 +207,452 @@ bool UnitRCWL9620::measureSingleshot(rcwl9620::Data& d)
         return false;
     }
 
-    bool timeouted{};
-    if (request_measurement()) {
-        m5::utility::delay(100);
-        return read_measurement(d, timeouted) && !timeouted;
+    if (requestSingleshot()) {
+        _clock.delay(_interface->ranging_time());
+        while (!pollSingleshot(d)) {
+            if (!inSingleshot()) {
+                return false;
+            }
+            _clock.delay(1);
+        }
+        return true;
     }
     return false;
 }
 
+bool UnitRCWL9620::requestSingleshot(singleshot_callback_t cb)
+{
+    if (inPeriodic()) {
+        M5_LIB_LOGD("Periodic measurements are running");
+        return false;
+    }
+    if (inBurst() || _draining) {
+        M5_LIB_LOGD("Burst measurement is running or draining");
+        return false;
+    }
+    if (_singleshot) {
+        M5_LIB_LOGD("Single shot measurement is already requested");
+        return false;
+    }
+    if (!request_measurement()) {
+        return false;
+    }
+    _singleshot          = true;
+    _singleshot_at       = _clock.millis();
+    _singleshot_callback = cb;
+    update_due();
+    return true;
+}
+
+bool UnitRCWL9620::singleshotReady() const
+{
+    return _singleshot && _clock.millis() - _singleshot_at >= _interface->ranging_time();
+}
+
+bool UnitRCWL9620::pollSingleshot(rcwl9620::Data& d)
+{
+    return singleshotReady() && complete_singleshot(d);
+}
+
+bool UnitRCWL9620::measureBurst(rcwl9620::BurstSample* out, const size_t k, const uint32_t spacing_ms)
+{
+    if (!requestBurst(out, k, spacing_ms)) {
+        return false;
+    }
+    while (!pollBurst()) {
+        _clock.delay(1);
+    }
+    return true;
+}
+
+bool UnitRCWL9620::requestBurst(rcwl9620::BurstSample* out, const size_t k, const uint32_t spacing_ms,
+                                burst_callback_t cb)
+{
+    if (!out || !k) {
+        M5_LIB_LOGE("Invalid arguments %p,%zu", out, k);
+        return false;
+    }
+    if (inPeriodic() || _singleshot || inBurst() || _draining) {
+        M5_LIB_LOGD("Other measurement is running");
+        return false;
+    }
+    if (_scheduler) {
+        M5_LIB_LOGD("Scheduled by the scheduler");
+        return false;
+    }
+    _burst_out       = out;
+    _burst_size      = k;
+    _burst_pos       = 0;
+    _burst_spacing   = std::max(spacing_ms, _interface->ranging_time());
+    _burst_requested = false;
+    _burst_callback  = cb;
+    // Issue the first request (completed by pollBurst() even if all samples are measured here)
+    step_burst();
+    update_due();
+    return true;
+}
+
+bool UnitRCWL9620::pollBurst()
+{
+    if (!inBurst()) {
+        return false;
+    }
+    if (!step_burst()) {
+        update_due();
+        return false;
+    }
+    complete_burst();
+    return true;
+}
+
+bool UnitRCWL9620::step_burst()
+{
+    while (_burst_pos < _burst_size) {
+        auto& s  = _burst_out[_burst_pos];
+        auto now = _clock.millis();
+        if (!_burst_requested) {
+            // Spaced from the previous request
+            if (_burst_pos && now - _burst_at < _burst_spacing) {
+                return false;
+            }
+            s         = BurstSample{};
+            _burst_at = now;
+            if (!request_measurement()) {
+                M5_LIB_LOGW("Failed to request %zu", _burst_pos);
+                ++_burst_pos;  // Invalid sample
+                continue;
+            }
+            s.timestamp.request_us = _clock.micros();
+            _burst_requested       = true;
+        }
+        if (now - _burst_at < _interface->ranging_time()) {
+            return false;
+        }
+        bool timeouted{};
+        const bool completed = read_measurement(s.data, timeouted);
+        if (!completed) {
+            if (_clock.millis() - _burst_at < singleshot_timeout) {
+                // Try again on the next call
+                return false;
+            }
+            M5_LIB_LOGW("Burst measurement timed out %zu", _burst_pos);
+            _interface->reset();
+        }
+        // Data is invalid after Timeout has occurred
+        s.timestamp.read_us = _clock.micros();
+        s.valid             = completed && !timeouted;
+        _burst_requested    = false;
+        ++_burst_pos;
+    }
+    return true;
+}
+
+void UnitRCWL9620::complete_burst()
+{
+    auto out        = _burst_out;
+    _burst_out      = nullptr;
+    auto cb         = std::move(_burst_callback);
+    _burst_callback = nullptr;
+    update_due();
+    if (cb) {
+        cb(*this, out, _burst_size);
+    }
+}
+
+bool UnitRCWL9620::complete_singleshot(rcwl9620::Data& d)
+{
+    bool timeouted{};
+    bool completed = read_measurement(d, timeouted);
+    if (!completed && _clock.millis() - _singleshot_at < singleshot_timeout) {
+        // Try again on the next call
+        return false;
+    }
+    if (!completed) {
+        M5_LIB_LOGW("Single shot measurement timed out");
+        _interface->reset();
+    }
+    // Data is invalid after Timeout has occurred
+    const bool valid = completed && !timeouted;
+    _singleshot      = false;
+    if (_singleshot_callback) {
+        auto cb              = std::move(_singleshot_callback);
+        _singleshot_callback = nullptr;
+        update_due();
+        cb(*this, d, valid);
+    }
+    return valid;
+}
+
+Timestamp UnitRCWL9620::oldestTimestamp() const
+{
+    return (_timestamps && !empty_periodic_measurement_data()) ? (*_timestamps)[_timestamps->size() - _data->size()]
+                                                               : Timestamp{};
+}
+
+Timestamp UnitRCWL9620::latestTimestamp() const
+{
+    return (_timestamps && !empty_periodic_measurement_data()) ? (*_timestamps)[_timestamps->size() - 1]
+                                                               : Timestamp{};
+}
+
+FilteredData UnitRCWL9620::oldestFiltered() const
+{
+    return (_filtered && !empty_periodic_measurement_data()) ? (*_filtered)[_filtered->size() - _data->size()]
+                                                             : FilteredData{};
+}
+
+FilteredData UnitRCWL9620::latestFiltered() const
+{
+    return (_filtered && !empty_periodic_measurement_data()) ? (*_filtered)[_filtered->size() - 1]
+                                                             : FilteredData{};
+}
+
+void UnitRCWL9620::store_measurement(const rcwl9620::Data& d)
+{
+    Timestamp ts{};
+    if (_timestamps || _motion) {
+        ts.request_us = _interface->request_us();
+        ts.read_us    = _clock.micros();
+    }
+    store_measurement(d, ts);
+}
+
+void UnitRCWL9620::store_measurement(const rcwl9620::Data& d, const rcwl9620::Timestamp& ts)
+{
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    const bool full = _data->full();
+#endif
+    // Not overwritten if lock-free, the parallel rings are pushed only if stored to keep the alignment
+    if (!_data->push_back(d)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+        _stats.dropped();
+#endif
+        return;
+    }
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    if (full) {
+        _stats.overwritten();
+    }
+#endif
+    if (_timestamps) {
+        _timestamps->push_back(ts);
+    }
+    uint32_t um = d.distance_um();
+    if (_filtered) {
+        bool outlier{};
+        um = _filter->apply(um, outlier);
+        FilteredData fd{};
+        fd.data.raw = {(uint8_t)(um >> 16), (uint8_t)(um >> 8), (uint8_t)um};
+        fd.flags    = outlier ? FilteredData::OUTLIER : 0;
+        _filtered->push_back(fd);
+    }
+    if (_motion) {
+        // Out of range means no target
+        if (d.raw_distance() < _max_range_um) {
+            _motion->update(um, ts.read_us);
+        } else {
+            _motion->reset();
+        }
+    }
+    if (_zones && _zones->size()) {
+        _zones->update(um);
+    }
+}
+
+void UnitRCWL9620::adapt_interval(const bool completed, const bool timeouted)
+{
+    const uint32_t elapsed_ms = (_clock.micros() - _interface->request_us()) / 1000;
+    if (completed) {
+        // Timeout of the echo means out of range, not the latency
+        if (!timeouted) {
+            _adaptive->success(elapsed_ms, !_read_failed);
+        }
+        _read_failed = false;
+    } else if (!_read_failed) {
+        _adaptive->failure(elapsed_ms);
+        _read_failed = true;
+    }
+    _interval = _adaptive->interval();
+}
+
+int8_t UnitRCWL9620::addZone(const rcwl9620::Zones::zone_t& z, rcwl9620::Zones::callback_t cb)
+{
+    if (!_zones) {
+        _zones.reset(new (std::nothrow) Zones());
+        if (!_zones) {
+            M5_LIB_LOGE("Failed to allocate");
+            return -1;
+        }
+    }
+    return _zones->add(z, cb);
+}
+
+void UnitRCWL9620::reset_features()
+{
+    if (_filter) {
+        _filter->reset();
+    }
+    if (_motion) {
+        _motion->reset();
+    }
+    if (_zones) {
+        _zones->reset();
+    }
+}
+
+void UnitRCWL9620::update_due()
+{
+    if (_background) {
+        // Samples may arrive at any time, and the interface is owned by the task
+        _due = 0;
+        return;
+    }
+
+    // Not earlier than the outstanding request should be read (e.g. backoff after NACK, echo window)
+    const elapsed_time_t ready =
+        _clock.millis() + (_interface ? (_interface->remaining_us(_clock.micros()) + 999) / 1000 : 0);
+
+    elapsed_time_t due{NO_DUE};
+    if (_singleshot && _singleshot_callback) {
+        due = std::max<elapsed_time_t>(_singleshot_at + _interface->ranging_time(), ready);
+    }
+    if (_draining) {
+        due = std::min<elapsed_time_t>(due, std::max<elapsed_time_t>(_drain_at, ready));
+    }
+    if (recovering()) {
+        const elapsed_time_t now = _clock.millis();
+        const int32_t remaining  = (int32_t)(_recovery->next() - (uint32_t)now);
+        _due                     = std::min<elapsed_time_t>(due, now + std::max<int32_t>(remaining, 0));
+        return;
+    }
+    if (inBurst() && _burst_callback) {
+        elapsed_time_t next = _burst_at + _burst_spacing;
+        if (_burst_requested) {
+            next = std::max<elapsed_time_t>(_burst_at + _interface->ranging_time(), ready);
+        }
+        due = (_burst_pos >= _burst_size) ? 0 : std::min(due, next);
+    }
+    if (inPeriodic() && !_scheduler) {
+        due = std::min<elapsed_time_t>(due, _latest ? std::max<elapsed_time_t>(_latest + _interval, ready) : 0);
+    }
+    _due = due;
+}
+
+bool UnitRCWL9620::startBackgroundMeasurement(const uint32_t interval, const rcwl9620::Worker::config_t& wcfg)
+{
+    if (inPeriodic() || _singleshot || inBurst() || _draining) {
+        return false;
+    }
+    if (_scheduler) {
+        M5_LIB_LOGD("Scheduled by the scheduler");
+        return false;
+    }
+    if (interval < minimum_interval()) {
+        M5_LIB_LOGE("Interval must be greater equal %u, (%u)", minimum_interval(), interval);
+        return false;
+    }
+    if (!_bg) {
+        _bg.reset(new (std::nothrow) background_t());
+        if (!_bg) {
+            M5_LIB_LOGE("Failed to allocate");
+            return false;
+        }
+    }
+    if (!prepare_ring(_bg->queue, stored_size(), false)) {
+        return false;
+    }
+    _bg->queue->clear();
+
+    if (!request_measurement()) {
+        return false;
+    }
+    _interval = interval;
+    _latest   = _clock.millis();
+    _bg->cfg  = wcfg;
+    reset_features();
+    _bg->dropped.store(0, std::memory_order_relaxed);
+    if (!start_worker()) {
+        _interface->reset();
+        return false;
+    }
+    _periodic = true;
+    if (_recovery) {
+        _recovery->begin(_latest);
+    }
+    update_due();
+    return true;
+}
+
+bool UnitRCWL9620::start_worker()
+{
+    _bg->next = _latest + _interval;
+    _bg->failed.store(false, std::memory_order_relaxed);
+    _background = true;
+    _bg_resume  = false;
+    // Members used in the task are published by the start of the task
+    if (!_bg->worker.start([this](uint32_t& wait_ms) { return background_step(wait_ms); }, _bg->cfg)) {
+        _background = false;
+        return false;
+    }
+    return true;
+}
+
+bool UnitRCWL9620::background_step(uint32_t& wait_ms)
+{
+    const types::elapsed_time_t now = _clock.millis();
+    if (now < _bg->next) {
+        wait_ms = _bg->next - now;
+        return true;
+    }
+
+    bool timeouted{};
+    TimedData td{};
+    if (!read_measurement(td.data, timeouted)) {
+        wait_ms = 1;  // Not ready
+        return true;
+    }
+    record_lateness(_bg->next);
+    // Data is invalid after Timeout has occurred
+    if (!timeouted) {
+        td.timestamp.request_us = _interface->request_us();
+        td.timestamp.read_us    = _clock.micros();
+        if (!_bg->queue->push_back(td)) {
+            _bg->dropped.fetch_add(1, std::memory_order_relaxed);
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+            _stats.dropped();
+#endif
+        }
+    }
+    if (!request_measurement()) {
+        _bg->failed.store(true, std::memory_order_release);
+        return false;
+    }
+    _bg->next = _clock.millis() + _interval;
+    wait_ms  = _interval;
+    return true;
+}
+
+void UnitRCWL9620::drain_background()
+{
+    TimedData td{};
+    while (_bg->queue->drain(&td, 1)) {
+        store_measurement(td.data, td.timestamp);
+        _updated = true;
+    }
+    if (_updated) {
+        _latest = _clock.millis();
+    }
+}
+
 //
 bool UnitRCWL9620::start_periodic_measurement(const uint32_t interval)
 {
-    if (inPeriodic()) {
+    if (inPeriodic() || _singleshot || inBurst() || _draining) {
+        return false;
+    }
+    if (_scheduler) {
+        M5_LIB_LOGD("Scheduled by the scheduler");
         return false;
     }
 
@@ -190,21 +664,93 @@ bool UnitRCWL9620::start_periodic_measurement(const uint32_t interval)
     _periodic = request_measurement();
     if (_periodic) {
         _interval = interval;
-        _latest   = m5::utility::millis();
+        _latest   = _clock.millis();
+        reset_features();
+        _read_failed = false;
+        if (_adaptive) {
+            _adaptive->start(interval, minimum_interval());
+            _interval = _adaptive->interval();
+        }
+        if (_recovery) {
+            _recovery->begin(_latest);
+        }
     }
+    update_due();
     return _periodic;
 }
 
+void UnitRCWL9620::fault_periodic()
+{
+    if (!_recovery) {
+        _periodic = _bg_resume = false;
+        M5_LIB_LOGE("Periodic measurements have been suspended");
+        return;
+    }
+    M5_LIB_LOGW("Failed to request, recovering");
+    _recovery->fault(_clock.millis());
+}
+
+void UnitRCWL9620::recover_periodic()
+{
+    const elapsed_time_t now = _clock.millis();
+    if (!_recovery->due(now)) {
+        return;
+    }
+    if (_recovery->config().bus_recovery) {
+        _interface->recover();
+    }
+    if (request_measurement()) {
+        _latest = _clock.millis();
+        if (!_bg_resume || start_worker()) {
+            _recovery->recovered(now);
+            M5_LIB_LOGI("Periodic measurements have been resumed");
+            return;
+        }
+        _interface->reset();
+    }
+    if (!_recovery->failed(now)) {
+        _periodic = _bg_resume = false;
+        M5_LIB_LOGE("Periodic measurements have been suspended");
+    }
+}
+
 bool UnitRCWL9620::stop_periodic_measurement()
 {
+    if (_scheduler) {
+        M5_LIB_LOGD("Scheduled by the scheduler");
+        return false;
+    }
+    if (_background) {
+        _bg->worker.stop();
+        _background = false;
+        drain_background();
+    }
+    if (recovering() || (inPeriodic() && !_interface->in_flight())) {
+        // No outstanding request
+        end_service();
+        _periodic = _bg_resume = false;
+        update_due();
+        return true;
+    }
+    end_service();
+    if (_draining) {
+        // Finish the non-blocking stop
+        while (_draining) {
+            drain_periodic();
+            if (_draining) {
+                _clock.delay(1);
+            }
+        }
+        return true;
+    }
     if (inPeriodic()) {
         // Since the request has already been issued, the value should be retrieved
         auto it  = interval();
-        auto dms = it - (m5::utility::millis() - updatedMillis());
+        auto dms = it - (_clock.millis() - updatedMillis());
         if (dms > it) {
             dms = it;
         }
-        m5::utility::delay(dms);
+        _clock.delay(dms);
 
         uint32_t cnt{8};
         bool timeouted{};
@@ -212,24 +758,108 @@ bool UnitRCWL9620::stop_periodic_measurement()
         do {
             if (read_measurement(discard, timeouted)) {
                 _periodic = false;
+                update_due();
                 return true;
             }
-            m5::utility::delay(1);
+            _clock.delay(1);
         } while (cnt--);
     }
     return false;
 }
 
+bool UnitRCWL9620::requestStopPeriodicMeasurement(idle_callback_t cb)
+{
+    if (_scheduler) {
+        M5_LIB_LOGD("Scheduled by the scheduler");
+        return false;
+    }
+    if (!inPeriodic()) {
+        return false;
+    }
+    if (_background) {
+        _bg->worker.stop();
+        _background = false;
+        drain_background();
+    }
+    if (recovering() || !_interface->in_flight()) {
+        // No outstanding request, idle now
+        end_service();
+        _periodic = _bg_resume = false;
+        update_due();
+        if (cb) {
+            cb(*this);
+        }
+        return true;
+    }
+    end_service();
+    // The request has already been issued, and read after the ranging time
+    const uint32_t elapsed_ms = (_clock.micros() - _interface->request_us()) / 1000;
+    const uint32_t ranging    = _interface->ranging_time();
+    _drain_at                 = _clock.millis() + (elapsed_ms < ranging ? ranging - elapsed_ms : 0);
+    _periodic                 = false;
+    _draining                 = true;
+    _idle_callback            = cb;
+    update_due();
+    return true;
+}
+
+void UnitRCWL9620::drain_periodic()
+{
+    // Nothing to read if no request is outstanding (e.g. GPIO without the capture)
+    if (_interface->in_flight()) {
+        const auto now = _clock.millis();
+        if (now < _drain_at) {
+            return;
+        }
+        bool timeouted{};
+        Data discard{};
+        if (!read_measurement(discard, timeouted)) {
+            if (now - _drain_at < singleshot_timeout) {
+                // Try again on the next call
+                return;
+            }
+            M5_LIB_LOGW("Outstanding request is not read");
+            _interface->reset();
+        }
+    }
+    _draining      = false;
+    auto cb        = std::move(_idle_callback);
+    _idle_callback = nullptr;
+    update_due();
+    if (cb) {
+        cb(*this);
+    }
+}
+
 bool UnitRCWL9620::request_measurement()
 {
     // Only write command
     //    return writeRegister(MEASURE_DISTANCE, nullptr, 0);
-    return _interface->request_measurement();
+
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    const uint32_t start_us = _clock.micros();
+#endif
+    const bool ret = _interface->request_measurement();
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    _stats.request(_clock.micros() - start_us, ret);
+#endif
+    return ret;
 }
 
 bool UnitRCWL9620::read_measurement(rcwl9620::Data& d, bool& timeouted)
 {
-    return _interface->read_measurement(d, timeouted);
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    const uint32_t start_us = _clock.micros();
+#endif
+    const bool ret = _interface->read_measurement(d, timeouted);
+    // Clamp to the maximum range if limited
+    if (ret && !timeouted && _max_range_um < Data::MAX_DISTANCE_UM && d.raw_distance() > _max_range_um) {
+        d.raw = {(uint8_t)(_max_range_um >> 16), (uint8_t)(_max_range_um >> 8), (uint8_t)_max_range_um};
+    }
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    _stats.read(_clock.micros() - start_us, ret, timeouted);
+#endif
+    return ret;
 }
 
 }  // namespace unit
@@ -11,10 +11,23 @@
 #define M5_UNIT_DISTANCE_UNIT_RCWL9620_HPP
 
 #include <M5UnitComponent.hpp>
-#include <m5_utility/container/circular_buffer.hpp>
+#include "rcwl9620/echo_capture.hpp"
+#include "rcwl9620/ring_buffer.hpp"
+#include "rcwl9620/filter.hpp"
+#include "rcwl9620/motion.hpp"
+#include "rcwl9620/zones.hpp"
+#include "rcwl9620/recovery.hpp"
+#include "rcwl9620/stats.hpp"
+#include "rcwl9620/adaptive_interval.hpp"
+#include "rcwl9620/readiness.hpp"
+#include "rcwl9620/worker.hpp"
+#include "rcwl9620/clock.hpp"
 #include <limits>  // NaN
 #include <cmath>
 #include <array>
+#include <functional>
+#include <new>
+#include <cstddef>
 
 namespace m5 {
 namespace unit {
@@ -34,19 +47,163 @@ struct Data {
 
     static constexpr float MAX_DISTANCE{4500.f};
     static constexpr float MIN_DISTANCE{20.f};
+    static constexpr uint32_t MAX_DISTANCE_UM{4500000};
+    static constexpr uint32_t MIN_DISTANCE_UM{20000};
 
     //! Get distance(mm)
     inline float distance() const
     {
-        float fd = raw_distance() / 1000.f;
-        return std::fmax(std::fmin(fd, MAX_DISTANCE), MIN_DISTANCE);
+        // Same result as clamping raw_distance() / 1000.f, since the limits are exact in float
+        return distance_um() / 1000.f;
+    }
+    //! Get distance(um)
+    inline uint32_t distance_um() const
+    {
+        return clamp_um(raw_distance());
+    }
+    //! Get distance(mm) truncated to integer
+    inline uint16_t distance_mm_u16() const
+    {
+        return to_mm_u16(raw_distance());
     }
     inline uint32_t raw_distance() const
     {
         return ((uint32_t)raw[0] << 16) | ((uint32_t)raw[1] << 8) | (uint32_t)raw[2];
     }
+
+    ///@name Conversion
+    ///@{
+    //! @brief Clamp the raw distance(um) to the measurable range
+    static constexpr uint32_t clamp_um(const uint32_t um)
+    {
+        return um < MIN_DISTANCE_UM ? MIN_DISTANCE_UM : (um > MAX_DISTANCE_UM ? MAX_DISTANCE_UM : um);
+    }
+    //! @brief Raw distance(um) to clamped distance(mm) truncated to integer
+    static constexpr uint16_t to_mm_u16(const uint32_t um)
+    {
+        return static_cast<uint16_t>(clamp_um(um) / 1000U);
+    }
+    ///@}
 };
 
+//! @brief Speed of sound used by default (cm/s)
+constexpr uint32_t SPEED_OF_SOUND{34300};
+
+/*!
+  @brief Speed of sound in air
+  @param celsius Air temperature
+  @return Speed of sound (cm/s)
+ */
+constexpr uint32_t speed_of_sound(const float celsius)
+{
+    return static_cast<uint32_t>(33145.f + 60.7f * celsius + 0.5f);
+}
+
+/*!
+  @brief Time of flight to distance
+  @param duration_us Echo pulse width (us)
+  @param speed_cm_s Speed of sound (cm/s)
+  @return Distance (um), saturated to the range of the raw data
+  @note Integer only (32-bit), truncated to um
+ */
+constexpr uint32_t tof_to_um(const uint32_t duration_us, const uint32_t speed_cm_s = SPEED_OF_SOUND)
+{
+    // Round trip: us * cm/s * 10000 um/cm / 1000000 us/s / 2
+    return (speed_cm_s && duration_us > 0xFFFFFFFFU / speed_cm_s)
+               ? 0xFFFFFFU
+               : (duration_us * speed_cm_s / 200U > 0xFFFFFFU ? 0xFFFFFFU : duration_us * speed_cm_s / 200U);
+}
+
+/*!
+  @brief Distance to time of flight
+  @param um Distance (um), up to the range of the raw data
+  @param speed_cm_s Speed of sound (cm/s)
+  @return Echo pulse width (us)
+ */
+constexpr uint32_t um_to_tof(const uint32_t um, const uint32_t speed_cm_s = SPEED_OF_SOUND)
+{
+    return speed_cm_s ? (um > 0xFFFFFFU ? 0xFFFFFFU : um) * 200U / speed_cm_s : 0xFFFFFFFFU;
+}
+
+///@name Timings derived from the maximum range (GPIO)
+///@{
+//! @brief Maximum echo pulse width for the full range (us)
+constexpr uint32_t ECHO_TIMEOUT_US{50000};
+/*!
+  @brief Echo timeout for the maximum range
+  @param max_range_um Maximum range (um)
+  @param speed_cm_s Speed of sound (cm/s)
+  @return ECHO_TIMEOUT_US for the full range, otherwise the time of flight with 25% margin (us)
+ */
+constexpr uint32_t echo_timeout_us(const uint32_t max_range_um, const uint32_t speed_cm_s = SPEED_OF_SOUND)
+{
+    return max_range_um >= Data::MAX_DISTANCE_UM
+               ? ECHO_TIMEOUT_US
+               : (um_to_tof(max_range_um, speed_cm_s) + um_to_tof(max_range_um, speed_cm_s) / 4U);
+}
+//! @brief Minimum interval of the periodic measurement for the echo timeout (ms)
+constexpr uint32_t minimum_interval_ms(const uint32_t echo_timeout_us)
+{
+    return (echo_timeout_us + 999U) / 1000U;
+}
+///@}
+
+/*!
+  @struct Timestamp
+  @brief Capture timestamps of the measurement
+ */
+struct Timestamp {
+    uint32_t request_us{};  //!< Time of the request (us)
+    uint32_t read_us{};     //!< Time of the read (us)
+
+    //! @brief Time from the request to the read (us)
+    inline uint32_t latency_us() const
+    {
+        return read_us - request_us;
+    }
+};
+
+/*!
+  @struct TimedData
+  @brief Measurement data with the timestamps
+ */
+struct TimedData {
+    Data data{};
+    Timestamp timestamp{};
+};
+
+/*!
+  @struct BurstSample
+  @brief Sample of the burst measurement
+ */
+struct BurstSample {
+    Data data{};
+    Timestamp timestamp{};
+    bool valid{};  //!< False if not measured (e.g. failed to request, timed out)
+};
+
+/*!
+  @struct FilteredData
+  @brief Filtered measurement data
+ */
+struct FilteredData {
+    static constexpr uint8_t OUTLIER{0x01};  //!< The raw sample was rejected as outlier
+
+    Data data{};      //!< Filtered distance
+    uint8_t flags{};  //!< Filter flags
+
+    //! @brief Was the raw sample rejected as outlier?
+    inline bool outlier() const
+    {
+        return flags & OUTLIER;
+    }
+};
+
+//! @brief Due time meaning that update() has nothing to do until the state changes
+constexpr types::elapsed_time_t NO_DUE{std::numeric_limits<types::elapsed_time_t>::max()};
+
+class Scheduler;
+
 }  // namespace rcwl9620
 
 /*!
@@ -57,19 +214,67 @@ class UnitRCWL9620 : public Component, public PeriodicMeasurementAdapter<UnitRCW
     M5_UNIT_COMPONENT_HPP_BUILDER(UnitRCWL9620, 0x57);
 
 public:
+    /*!
+      @brief Callback for the completion of single shot measurement
+      @param unit The unit that measured
+      @param data Measured data
+      @param valid True if the data is valid
+     */
+    using singleshot_callback_t = std::function<void(UnitRCWL9620& unit, const rcwl9620::Data& data, const bool valid)>;
+    /*!
+      @brief Callback on completion of the burst measurement
+      @param unit The unit that measured
+      @param samples Measured samples
+      @param k Number of the samples
+     */
+    using burst_callback_t = std::function<void(UnitRCWL9620& unit, rcwl9620::BurstSample* samples, const size_t k)>;
+    /*!
+      @brief Callback on the unit becomes idle after the periodic measurement is stopped
+      @param unit The unit
+     */
+    using idle_callback_t = std::function<void(UnitRCWL9620& unit)>;
+
     /*!
       @struct config_t
       @brief Settings for begin
+      @note The optional features (filter, motion, adaptive interval and recovery) are allocated by begin()
+      only if enabled, so the unit without them stays small
      */
     struct config_t {
         //! Start periodic measurement on begin?
         bool start_periodic{true};
         //! Interval time if start on begin (ms) (100-)
         uint32_t interval_ms{250};
+        //! Store the timestamps of each periodic measurement data?
+        bool timestamp{false};
+        //! Filter applied to each periodic measurement data (disabled by default)
+        rcwl9620::Filter::config_t filter{};
+        //! Velocity estimation by each periodic measurement data (disabled by default)
+        rcwl9620::Motion::config_t motion{};
+        //! Adjust the interval of periodic measurement by the learned ranging latency?
+        bool adaptive_interval{false};
+        //! Settings of the adaptive interval, min_ms below the minimum interval of the unit is raised to it
+        rcwl9620::AdaptiveInterval::config_t adaptive{};
+        //! Readiness strategy of the read (I2C)
+        rcwl9620::Readiness::config_t readiness{};
+        /*!
+          Maximum range (mm) (Data::MIN_DISTANCE - Data::MAX_DISTANCE)
+          The distance is clamped to it, and the echo timeout and the minimum interval of GPIO are derived from it
+          @warning Echo of the farther object may be taken as the next measurement if shortened
+         */
+        uint16_t max_range_mm{4500};
+        //! Recovery of the periodic measurement when the request fails
+        rcwl9620::Recovery::config_t recovery{};
+        /*!
+          Store the periodic measurement data lock-free for the consumer in another context (e.g. the other core)?
+          If true, the data is not overwritten and the new one is dropped when full
+          @warning timestamp and filter cannot be used with it, begin() fails
+         */
+        bool lock_free{false};
     };
 
     explicit UnitRCWL9620(const uint8_t addr = DEFAULT_ADDRESS)
-        : Component(addr), _data{new m5::container::CircularBuffer<rcwl9620::Data>(1)}
+        : Component(addr)
     {
         auto ccfg  = component_config();
         ccfg.clock = 100 * 1000U;
@@ -77,6 +282,7 @@ public:
     }
     virtual ~UnitRCWL9620()
     {
+        release();
     }
 
     virtual bool begin() override;
@@ -103,6 +309,164 @@ public:
     {
         return !empty() ? oldest().distance() : std::numeric_limits<float>::quiet_NaN();
     }
+    //! @brief Oldest distance (um), 0 if empty
+    uint32_t distance_um() const
+    {
+        return !empty() ? oldest().distance_um() : 0;
+    }
+    //! @brief Oldest distance (mm) truncated to integer, 0 if empty
+    uint16_t distance_mm_u16() const
+    {
+        return !empty() ? oldest().distance_mm_u16() : 0;
+    }
+    /*!
+      @brief Timestamps of the oldest data
+      @note Valid if config_t::timestamp is true
+     */
+    rcwl9620::Timestamp oldestTimestamp() const;
+    /*!
+      @brief Timestamps of the latest data
+      @note Valid if config_t::timestamp is true
+     */
+    rcwl9620::Timestamp latestTimestamp() const;
+    //! @brief Oldest data with the timestamps
+    inline rcwl9620::TimedData oldestTimed() const
+    {
+        rcwl9620::TimedData td{};
+        td.data      = oldest();
+        td.timestamp = oldestTimestamp();
+        return td;
+    }
+    /*!
+      @brief Number of samples dropped because the stored data was full
+      @note Counted if config_t::lock_free is true
+     */
+    inline uint32_t droppedSamples() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+    ///@}
+
+    ///@name Filtered measurement data by periodic
+    ///@{
+    /*!
+      @brief Filtered data of the oldest data
+      @note Valid if config_t::filter is enabled
+     */
+    rcwl9620::FilteredData oldestFiltered() const;
+    /*!
+      @brief Filtered data of the latest data
+      @note Valid if config_t::filter is enabled
+     */
+    rcwl9620::FilteredData latestFiltered() const;
+    //! @brief Oldest filtered distance (mm)
+    inline float filteredDistance() const
+    {
+        return _filtered && !empty() ? oldestFiltered().data.distance() : std::numeric_limits<float>::quiet_NaN();
+    }
+    //! @brief Gets the filter
+    inline const rcwl9620::Filter& filter() const
+    {
+        return or_disabled(_filter);
+    }
+    ///@}
+
+    ///@name Motion estimation by periodic
+    ///@{
+    /*!
+      @brief Estimated velocity (mm/s, negative if approaching)
+      @note Valid if config_t::motion is enabled, NaN if not estimated yet
+      @note Estimated from the filtered distance if config_t::filter is enabled
+     */
+    inline float velocity_mm_s() const
+    {
+        return or_disabled(_motion).velocity_mm_s();
+    }
+    /*!
+      @brief Estimated time until the distance reaches the contact distance (ms)
+      @param contact_mm Contact distance (mm)
+      @return NaN if not approaching or not estimated
+     */
+    inline float timeToContact_ms(const float contact_mm = 0.0f) const
+    {
+        return or_disabled(_motion).timeToContact_ms(contact_mm);
+    }
+    //! @brief Gets the motion estimation
+    inline const rcwl9620::Motion& motion() const
+    {
+        return or_disabled(_motion);
+    }
+    ///@}
+
+    ///@name Zone detection by periodic
+    ///@{
+    /*!
+      @brief Add the zone evaluated on each periodic measurement data
+      @param z Zone
+      @param cb Callback on entering and leaving (optional), called in update()
+      @return Index of the zone, negative if failed
+      @note Evaluated by the filtered distance if config_t::filter is enabled
+      @note The zones are allocated on the first add
+     */
+    int8_t addZone(const rcwl9620::Zones::zone_t& z, rcwl9620::Zones::callback_t cb = nullptr);
+    //! @brief Remove all zones, and release them
+    inline void clearZones()
+    {
+        _zones.reset();
+    }
+    //! @brief Is the latest data in the zone?
+    inline bool inZone(const uint8_t index) const
+    {
+        return or_disabled(_zones).inside(index);
+    }
+    //! @brief Gets and clears the zones entered since the last take (bit n is the zone n)
+    inline uint8_t takeZoneEntered()
+    {
+        return _zones ? _zones->takeEntered() : 0;
+    }
+    //! @brief Gets and clears the zones left since the last take (bit n is the zone n)
+    inline uint8_t takeZoneLeft()
+    {
+        return _zones ? _zones->takeLeft() : 0;
+    }
+    //! @brief Gets the zones
+    inline const rcwl9620::Zones& zones() const
+    {
+        return or_disabled(_zones);
+    }
+    ///@}
+
+    ///@name Bulk access to the measurement data by periodic
+    ///@{
+    /*!
+      @brief Copy the stored data from the oldest
+      @param[out] out Output buffer
+      @param max Max number of elements of the output buffer
+      @return Number of data copied
+      @note The stored data is not removed
+     */
+    inline size_t readAll(rcwl9620::Data* out, const size_t max) const
+    {
+        return _data ? _data->read(out, max) : 0U;
+    }
+    /*!
+      @brief Copy and remove the stored data from the oldest
+      @param[out] out Output buffer
+      @param max Max number of elements of the output buffer
+      @return Number of data removed
+     */
+    inline size_t drain(rcwl9620::Data* out, const size_t max)
+    {
+        return _data ? _data->drain(out, max) : 0U;
+    }
+    /*!
+      @brief Gets the stored data as at most two contiguous segments without copy
+      @warning Valid until the next update() or any modification of the stored data
+     */
+    inline rcwl9620::RingBuffer<rcwl9620::Data>::view_t view() const
+    {
+        return _data ? _data->view() : rcwl9620::RingBuffer<rcwl9620::Data>::view_t{};
+    }
     ///@}
 
     ///@name Periodic measurement
@@ -124,6 +488,70 @@ public:
     {
         return PeriodicMeasurementAdapter<UnitRCWL9620, rcwl9620::Data>::stopPeriodicMeasurement();
     }
+    /*!
+      @brief Stop periodic measurement without blocking
+      @param cb Callback called when the unit becomes idle (optional)
+      @return True if successful
+      @details The unit is draining until the outstanding request is read (and discarded) by update()
+      @note Other measurements can not be started while draining
+    */
+    bool requestStopPeriodicMeasurement(idle_callback_t cb = nullptr);
+    //! @brief Is the outstanding request of the stopped periodic measurement pending?
+    inline bool draining() const
+    {
+        return _draining;
+    }
+    //! @brief Is no measurement running or pending?
+    inline bool idle() const
+    {
+        return !inPeriodic() && !_draining && !_singleshot && !inBurst();
+    }
+    /*!
+      @brief Gets the adaptive interval
+      @details Learned latency, its histogram and the current interval
+      @note Valid if config_t::adaptive_interval is true.
+      The interval given to startPeriodicMeasurement is the upper bound
+     */
+    inline const rcwl9620::AdaptiveInterval& adaptiveInterval() const
+    {
+        return or_disabled(_adaptive);
+    }
+    ///@}
+
+    ///@name Background measurement
+    ///@{
+    /*!
+      @brief Start periodic measurement in the background task
+      @param interval Measurement interval (ms)
+      @param wcfg Settings of the task (core, priority and stack size)
+      @return True if successful
+      @details The request and the read are done in the dedicated task, and the samples are handed over
+      through the lock-free queue of stored_size. update() moves them to the periodic measurement data
+      without waiting, so a slow loop does not delay the reads
+      @note inPeriodic() is true while running, stopPeriodicMeasurement() also stops it
+      @note The adaptive interval is not applied
+      @warning The bus is accessed from the task, the bus driver must be thread-safe (e.g. Wire on ESP32)
+     */
+    bool startBackgroundMeasurement(const uint32_t interval,
+                                    const rcwl9620::Worker::config_t& wcfg = rcwl9620::Worker::config_t{});
+    /*!
+      @brief Stop periodic measurement in the background task
+      @return True if successful
+     */
+    inline bool stopBackgroundMeasurement()
+    {
+        return (_background || _bg_resume) && stop_periodic_measurement();
+    }
+    //! @brief Is the periodic measurement running in the background task?
+    inline bool inBackground() const
+    {
+        return _background;
+    }
+    //! @brief Number of samples dropped because the queue of the task was full
+    inline uint32_t backgroundDropped() const
+    {
+        return _bg ? _bg->dropped.load(std::memory_order_relaxed) : 0;
+    }
     ///@}
 
     ///@name Single shot measurement
@@ -135,8 +563,253 @@ public:
       @warning Blocked until measurement is complete
     */
     bool measureSingleshot(rcwl9620::Data& d);
+    /*!
+      @brief Request single shot measurement without blocking
+      @param cb Callback called on completion (optional)
+      @return True if successful
+      @note Complete the measurement with pollSingleshot()
+      @note If callback is set, update() also completes the measurement and calls it
+      @warning During periodic detection runs, an error is returned
+      @warning GPIO without the echo capture triggers and waits for the echo pulse on the completion,
+      so pollSingleshot() and update() block up to echoTimeout_us(). Attach the capture to avoid it
+    */
+    bool requestSingleshot(singleshot_callback_t cb = nullptr);
+    //! @brief Is the requested single shot measurement pending?
+    inline bool inSingleshot() const
+    {
+        return _singleshot;
+    }
+    //! @brief Is the requested single shot measurement ready to read?
+    bool singleshotReady() const;
+    /*!
+      @brief Complete the requested single shot measurement without blocking
+      @param[out] d Measuerd data
+      @return True if the measurement is complete and the data is valid
+      @note Returns false while the measurement is not ready
+      @note Gives up if not read within the timeout, and the request is discarded
+      @warning Blocks up to echoTimeout_us() if GPIO without the echo capture
+    */
+    bool pollSingleshot(rcwl9620::Data& d);
+    ///@}
+
+    ///@name Burst measurement
+    ///@{
+    /*!
+      @brief Measure the samples back-to-back
+      @param[out] out Samples (k elements)
+      @param k Number of the samples
+      @param spacing_ms Time between the requests (ms), the ranging time if shorter
+      @return True if completed, see BurstSample::valid for each sample
+      @warning During periodic, single shot or scheduled measurement, an error is returned
+      @warning Blocked until all samples are measured
+    */
+    bool measureBurst(rcwl9620::BurstSample* out, const size_t k, const uint32_t spacing_ms = 0);
+    /*!
+      @brief Request the burst measurement without blocking
+      @param[out] out Samples (k elements), must be valid until completed
+      @param k Number of the samples
+      @param spacing_ms Time between the requests (ms), the ranging time if shorter
+      @param cb Callback called on completion (optional)
+      @return True if successful
+      @note Proceed the measurement with pollBurst()
+      @note If callback is set, update() also proceeds the measurement and calls it
+      @note The next request is issued right after the read of the previous sample if the spacing has elapsed
+    */
+    bool requestBurst(rcwl9620::BurstSample* out, const size_t k, const uint32_t spacing_ms = 0,
+                      burst_callback_t cb = nullptr);
+    //! @brief Is the requested burst measurement in progress?
+    inline bool inBurst() const
+    {
+        return _burst_out != nullptr;
+    }
+    //! @brief Number of the samples completed in the current (or the last) burst measurement
+    inline size_t burstCompleted() const
+    {
+        return _burst_pos;
+    }
+    /*!
+      @brief Proceed the requested burst measurement without blocking
+      @return True if all samples are completed on this call
+    */
+    bool pollBurst();
+    ///@}
+
+    ///@name Speed of sound (GPIO)
+    ///@{
+    //! @brief Gets the speed of sound used for the time of flight (cm/s)
+    inline uint32_t speedOfSound() const
+    {
+        return _speed_of_sound;
+    }
+    /*!
+      @brief Set the speed of sound used for the time of flight
+      @param cm_s Speed of sound (cm/s)
+      @note See also rcwl9620::speed_of_sound() for the temperature compensation
+      @note It is used only for GPIO connection, I2C unit converts by itself
+     */
+    inline void speedOfSound(const uint32_t cm_s)
+    {
+        _speed_of_sound = cm_s;
+    }
     ///@}
 
+    ///@name Recovery of periodic measurement
+    ///@{
+    /*!
+      @brief Is the periodic measurement recovering from the failed request?
+      @note inPeriodic() is true while recovering
+     */
+    inline bool recovering() const
+    {
+        return _periodic && _recovery && _recovery->recovering();
+    }
+    //! @brief Gets the counters of the recovery
+    inline rcwl9620::Recovery::counters_t recoveryCounters() const
+    {
+        return or_disabled(_recovery).counters();
+    }
+    /*!
+      @brief Time the periodic measurement has been in service except in recovery (ms)
+      @note Valid if config_t::recovery is enabled
+     */
+    inline uint32_t uptime_ms() const
+    {
+        return or_disabled(_recovery).uptime(_clock.millis());
+    }
+    /*!
+      @brief Ratio of the uptime to the time since the periodic measurement was started (0.0 - 1.0)
+      @note Valid if config_t::recovery is enabled
+     */
+    inline float availability() const
+    {
+        return or_disabled(_recovery).availability(_clock.millis());
+    }
+    //! @brief Gets the recovery
+    inline const rcwl9620::Recovery& recovery() const
+    {
+        return or_disabled(_recovery);
+    }
+    ///@}
+
+    ///@name Range
+    ///@{
+    //! @brief Maximum range (um) by config_t::max_range_mm
+    inline uint32_t maxRange_um() const
+    {
+        return _max_range_um;
+    }
+    //! @brief Echo timeout derived from the maximum range and the speed of sound (us) (GPIO)
+    inline uint32_t echoTimeout_us() const
+    {
+        return rcwl9620::echo_timeout_us(_max_range_um, _speed_of_sound);
+    }
+    ///@}
+
+    ///@name Read statistics
+    ///@{
+    /*!
+      @brief Gets the counters of the read
+      @details Reads, retries, NACKs and dropped requests, for tuning the bus load
+      @note Counted for I2C connection
+     */
+    inline rcwl9620::Readiness::counters_t readCounters() const
+    {
+        return _interface ? _interface->counters() : rcwl9620::Readiness::counters_t{};
+    }
+    ///@}
+
+    ///@name Instrumentation
+    ///@{
+    //! @brief Is the instrumentation compiled in? (M5_UNIT_RCWL9620_ENABLE_STATS)
+    static constexpr bool statsEnabled()
+    {
+        return M5_UNIT_RCWL9620_ENABLE_STATS != 0;
+    }
+    /*!
+      @brief Gets the snapshot of the statistics
+      @details Latency histograms of the request and the read, lateness of the periodic measurement,
+      counters of the overruns and the lost samples, and bytes on the bus
+      @note All zero if not compiled in
+      @note Measurements by the scheduler are not included in the lateness
+     */
+    inline rcwl9620::Stats stats() const
+    {
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+        return _stats.snapshot();
+#else
+        return rcwl9620::Stats{};
+#endif
+    }
+    //! @brief Reset the statistics
+    inline void resetStats()
+    {
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+        _stats.reset();
+#endif
+    }
+    ///@}
+
+    ///@name Echo capture (GPIO)
+    ///@{
+    /*!
+      @brief Attach the echo capture
+      @param capture Echo capture (nullptr to detach)
+      @note Call before begin(). It is used only for GPIO connection
+      @note If attached, the trigger and the collection of the echo pulse are separated,
+      and update() does not wait for the echo pulse
+      @warning The lifetime of the capture must be longer than the unit
+     */
+    inline void attachEchoCapture(rcwl9620::EchoCapture* capture)
+    {
+        _capture = capture;
+    }
+    //! @brief Gets the attached echo capture
+    inline rcwl9620::EchoCapture* echoCapture()
+    {
+        return _capture;
+    }
+    ///@}
+
+    ///@name Clock
+    ///@{
+    /*!
+      @brief Attach the clock
+      @param clock Clock used for the time and the wait of the unit (nullptr to use m5::utility)
+      @note Call before begin()
+      @warning The background task waits in the real time regardless of the clock
+      @warning The units scheduled by the same rcwl9620::Scheduler must use the same clock
+      @warning The lifetime of the clock must be longer than the unit
+     */
+    inline void attachClock(rcwl9620::Clock* clock)
+    {
+        _clock.attach(clock);
+    }
+    //! @brief Gets the clock, rcwl9620::Clock::system() if not attached
+    inline rcwl9620::Clock& clock() const
+    {
+        return _clock.get();
+    }
+    ///@}
+
+    /*!
+      @brief Time update() has something to do next
+      @return Time (ms) comparable with clock().millis(), rcwl9620::NO_DUE if nothing is scheduled
+      @details update() returns immediately before this time unless forced.
+      Due for the periodic measurement and the single shot measurement with callback,
+      and not earlier than the outstanding request should be read (backoff after NACK, echo window of the capture)
+      @note The units scheduled by rcwl9620::Scheduler are never due, the scheduler proceeds them
+     */
+    inline types::elapsed_time_t nextDue() const
+    {
+        return _due;
+    }
+
+    //! @brief Gets the scheduler the unit belongs to
+    inline rcwl9620::Scheduler* scheduler()
+    {
+        return _scheduler;
+    }
+
     ///@cond0
     // Class that abstracts the interaction between classes and adapters
     class Interface {
@@ -149,13 +822,103 @@ public:
         }
         virtual bool read_measurement(rcwl9620::Data&, bool&) = 0;
         virtual bool request_measurement()                    = 0;
+        //! @brief Discard the outstanding request
+        virtual void reset()
+        {
+        }
+        //! @brief Recover the state of the bus, called before the recovery attempt if enabled
+        virtual void recover()
+        {
+            reset();
+        }
+        //! @brief Time required from request to readable (ms)
+        virtual uint32_t ranging_time() const = 0;
+        //! @brief Is the request outstanding? If not, read_measurement() is not needed to finish it
+        virtual bool in_flight() const
+        {
+            return true;
+        }
+        //! @brief Time until the outstanding request should be read again (us), 0 if now
+        virtual uint32_t remaining_us(const uint32_t) const
+        {
+            return 0;
+        }
+        //! @brief Time the last request was actually issued (us)
+        inline uint32_t request_us() const
+        {
+            return _request_us;
+        }
+        //! @brief Counters of the read
+        virtual rcwl9620::Readiness::counters_t counters() const
+        {
+            return rcwl9620::Readiness::counters_t{};
+        }
 
     protected:
+        //! @brief Clock of the unit
+        inline const rcwl9620::ClockRef& clock() const
+        {
+            return _unit._clock;
+        }
+        //! @brief Bytes transferred on the bus
+        inline void bus_transfer(const uint32_t bytes)
+        {
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+            _unit._stats.bus(bytes);
+#else
+            (void)bytes;
+#endif
+        }
+
         UnitRCWL9620& _unit;
+        uint32_t _request_us{};
+    };
+    // Deletes the interface, or only destructs it if constructed in the inline storage
+    struct interface_deleter_t {
+        void* storage;  // Zeroed by the value-initialization in std::unique_ptr
+        inline void operator()(Interface* p) const
+        {
+            if (static_cast<void*>(p) == storage) {
+                p->~Interface();
+            } else {
+                delete p;
+            }
+        }
     };
     ///@endcond
 
 protected:
+    friend class rcwl9620::Scheduler;
+
+    /*!
+      @brief Using the external storage for the data and the interface
+      @param addr Address
+      @param data Buffer of the periodic measurement data, its capacity is the stored size
+      (nullptr to allocate by begin())
+      @param interface_storage Storage for the interface (nullptr to allocate)
+      @param interface_size Size of the interface storage
+     */
+    UnitRCWL9620(const uint8_t addr, rcwl9620::RingBuffer<rcwl9620::Data>* data, void* interface_storage,
+                 const size_t interface_size)
+        : Component(addr), _data{data}, _interface_size{interface_size}
+    {
+        auto ccfg  = component_config();
+        ccfg.clock = 100 * 1000U;
+        if (data) {
+            ccfg.stored_size = data->capacity();
+        }
+        component_config(ccfg);
+        _interface.get_deleter().storage = interface_storage;
+    }
+    // Stop the task and destruct the interface, called before the external storage is destructed
+    inline void release()
+    {
+        if (_bg) {
+            _bg->worker.stop();
+        }
+        _interface.reset();
+    }
+
     bool request_measurement();
     bool read_measurement(rcwl9620::Data& d, bool& timeouted);
 
@@ -166,10 +929,109 @@ protected:
     {
         return _interface.get();
     }
+    // Create the interface for the adapter type
+    virtual Interface* create_interface(const Adapter::Type type);
+    // Construct the interface in the inline storage if it fits, otherwise allocate
+    template <class I, typename... Args>
+    Interface* make_interface(Args&&... args)
+    {
+        void* storage = _interface.get_deleter().storage;
+        if (storage && sizeof(I) <= _interface_size && alignof(I) <= alignof(std::max_align_t)) {
+            return new (storage) I(std::forward<Args>(args)...);
+        }
+        return new (std::nothrow) I(std::forward<Args>(args)...);
+    }
+
+    bool complete_singleshot(rcwl9620::Data& d);
+    // Proceed the burst measurement as far as possible without waiting, true if all samples are completed
+    bool step_burst();
+    void complete_burst();
+    // Read the outstanding request of the stopped periodic measurement, and call the idle callback
+    void drain_periodic();
+    // Start the recovery, or suspend if disabled
+    void fault_periodic();
+    // Attempt to resume the periodic measurement if due
+    void recover_periodic();
+    // Start the task of the background measurement, the request has been issued
+    bool start_worker();
+    // Time the periodic read completed later than the scheduled time (ms)
+    inline void record_lateness(const types::elapsed_time_t due)
+    {
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+        const types::elapsed_time_t now = _clock.millis();
+        _stats.lateness(now > due ? (uint32_t)(now - due) * 1000U : 0, _interval * 1000U);
+#else
+        (void)due;
+#endif
+    }
+    // Push the periodic measurement data (and the timestamps)
+    void store_measurement(const rcwl9620::Data& d);
+    void store_measurement(const rcwl9620::Data& d, const rcwl9620::Timestamp& ts);
+    void adapt_interval(const bool completed, const bool timeouted);
+    // Refresh the due time after the state is changed
+    void update_due();
+    // Reset the state of the features on the start of the periodic measurement
+    void reset_features();
+    // End the service of the periodic measurement for the recovery
+    inline void end_service()
+    {
+        if (_recovery) {
+            _recovery->end(_clock.millis());
+        }
+    }
+    // Instance of the feature, or the disabled one if not allocated
+    template <class T>
+    inline static const T& or_disabled(const std::unique_ptr<T>& p)
+    {
+        static const T disabled{};
+        return p ? *p : disabled;
+    }
+    // Called in the background task
+    bool background_step(uint32_t& wait_ms);
+    // Move the samples of the background task to the periodic measurement data
+    void drain_background();
 
-    M5_UNIT_COMPONENT_PERIODIC_MEASUREMENT_ADAPTER_HPP_BUILDER(UnitRCWL9620, rcwl9620::Data);
+    // Expanded M5_UNIT_COMPONENT_PERIODIC_MEASUREMENT_ADAPTER_HPP_BUILDER, _data is nullptr until begin()
+    friend class PeriodicMeasurementAdapter<UnitRCWL9620, rcwl9620::Data>;
+    inline rcwl9620::Data oldest_periodic_data() const
+    {
+        return (_data && !_data->empty()) ? _data->front().value() : rcwl9620::Data{};
+    }
+    inline rcwl9620::Data latest_periodic_data() const
+    {
+        return (_data && !_data->empty()) ? _data->back().value() : rcwl9620::Data{};
+    }
+    inline size_t available_periodic_measurement_data() const
+    {
+        return _data ? _data->size() : 0U;
+    }
+    inline bool empty_periodic_measurement_data() const
+    {
+        return !_data || _data->empty();
+    }
+    inline bool full_periodic_measurement_data() const
+    {
+        return _data && _data->full();
+    }
+    inline void discard_periodic_measurement_data()
+    {
+        if (_data) {
+            _data->pop_front();
+        }
+    }
+    inline void flush_periodic_measurement_data()
+    {
+        if (_data) {
+            _data->clear();
+        }
+    }
 
-    std::unique_ptr<m5::container::CircularBuffer<rcwl9620::Data>> _data{};
+    std::unique_ptr<rcwl9620::RingBuffer<rcwl9620::Data>> _data_owned{};  // nullptr if external or before begin()
+    rcwl9620::RingBuffer<rcwl9620::Data>* _data{};
+    // Pushed with _data, aligned to the latest since the adapter pops only _data
+    std::unique_ptr<rcwl9620::RingBuffer<rcwl9620::Timestamp>> _timestamps{};
+    // Same as _timestamps
+    std::unique_ptr<rcwl9620::RingBuffer<rcwl9620::FilteredData>> _filtered{};
 
     inline virtual uint32_t minimum_interval() const
     {
@@ -184,8 +1046,54 @@ protected:
     }
 
 private:
-    std::unique_ptr<Interface> _interface{};
+    std::unique_ptr<Interface, interface_deleter_t> _interface{};
+    size_t _interface_size{};
     config_t _cfg{};
+    rcwl9620::EchoCapture* _capture{};
+    rcwl9620::ClockRef _clock{};  // m5::utility if not attached
+    uint32_t _speed_of_sound{rcwl9620::SPEED_OF_SOUND};
+    uint32_t _max_range_um{rcwl9620::Data::MAX_DISTANCE_UM};
+    rcwl9620::Scheduler* _scheduler{};
+    // Optional features, allocated only if enabled
+    std::unique_ptr<rcwl9620::Filter> _filter{};
+    std::unique_ptr<rcwl9620::Motion> _motion{};
+    std::unique_ptr<rcwl9620::Zones> _zones{};
+    std::unique_ptr<rcwl9620::AdaptiveInterval> _adaptive{};
+    std::unique_ptr<rcwl9620::Recovery> _recovery{};
+    bool _read_failed{};  // First read of the cycle has failed
+    types::elapsed_time_t _due{rcwl9620::NO_DUE};
+    std::atomic<uint32_t> _dropped{};
+
+    // Background measurement, allocated on the first start
+    struct background_t {
+        std::unique_ptr<rcwl9620::RingBuffer<rcwl9620::TimedData>> queue{};
+        std::atomic<uint32_t> dropped{};
+        std::atomic<bool> failed{};
+        types::elapsed_time_t next{};  // Used only in the task
+        rcwl9620::Worker worker{};
+        rcwl9620::Worker::config_t cfg{};
+    };
+    std::unique_ptr<background_t> _bg{};
+    bool _background{};
+    bool _bg_resume{};  // Restart the task on the recovery
+#if M5_UNIT_RCWL9620_ENABLE_STATS
+    rcwl9620::StatsRecorder _stats{};
+#endif
+
+    bool _singleshot{};
+    types::elapsed_time_t _singleshot_at{};
+    singleshot_callback_t _singleshot_callback{};
+
+    rcwl9620::BurstSample* _burst_out{};
+    size_t _burst_size{}, _burst_pos{};
+    uint32_t _burst_spacing{};
+    types::elapsed_time_t _burst_at{};  // Time of the last request
+    bool _burst_requested{};
+    burst_callback_t _burst_callback{};
+
+    bool _draining{};
+    types::elapsed_time_t _drain_at{};  // Time the outstanding request is ready
+    idle_callback_t _idle_callback{};
 };
 
 ///@cond 0
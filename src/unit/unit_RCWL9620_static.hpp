@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file unit_RCWL9620_static.hpp
+  @brief RCWL9620 Unit for M5UnitUnified without the heap allocation of the data and the interface
+*/
+#ifndef M5_UNIT_DISTANCE_UNIT_RCWL9620_STATIC_HPP
+#define M5_UNIT_DISTANCE_UNIT_RCWL9620_STATIC_HPP
+
+#include "unit_RCWL9620.hpp"
+#include "rcwl9620/interface.hpp"
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+///@cond
+// Constructed before UnitRCWL9620 and destructed after it (base-from-member)
+template <size_t N, size_t IS>
+struct StaticStorage {
+    Data ring_storage[N + 1]{};
+    RingBuffer<Data> ring{ring_storage, N + 1};
+    alignas(std::max_align_t) uint8_t interface_storage[IS]{};
+};
+constexpr size_t max_size(const size_t a, const size_t b)
+{
+    return a > b ? a : b;
+}
+///@endcond
+}  // namespace rcwl9620
+
+/*!
+  @class m5::unit::UnitRCWL9620Static
+  @brief UnitRCWL9620 with the inline storage
+  @details The periodic measurement data and the interface are stored in the object itself,
+  so it can be placed in the static storage and no heap is used for them
+  @tparam N Stored size of the periodic measurement data (component_config_t::stored_size is fixed to it)
+  @tparam IS Size of the interface storage, the interface is allocated if larger than it
+  @note Timestamps, filtered data, the background measurement and the optional features
+  (e.g. the recovery enabled by default) are still allocated if enabled
+ */
+template <size_t N,
+          size_t IS = rcwl9620::max_size(sizeof(rcwl9620::InterfaceI2C), sizeof(rcwl9620::InterfaceGPIO))>
+class UnitRCWL9620Static : private rcwl9620::StaticStorage<N, IS>, public UnitRCWL9620 {
+    static_assert(N > 0, "N must be greater than 0");
+    using storage_t = rcwl9620::StaticStorage<N, IS>;
+
+public:
+    explicit UnitRCWL9620Static(const uint8_t addr = DEFAULT_ADDRESS)
+        : storage_t(), UnitRCWL9620(addr, &this->ring, this->interface_storage, IS)
+    {
+    }
+    virtual ~UnitRCWL9620Static()
+    {
+        release();
+    }
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
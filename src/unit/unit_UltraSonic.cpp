@@ -30,6 +30,11 @@ bool UnitUltraSonicI2C::begin()
     return UnitRCWL9620::begin();
 }
 
+UnitRCWL9620::Interface* UnitUltraSonicI2C::create_interface(const Adapter::Type)
+{
+    return make_interface<rcwl9620::InterfaceI2C>(*this);
+}
+
 // class UnitUltraSonicIO
 const char UnitUltraSonicIO::name[] = "UnitUltraSonicIO";
 const types::uid_t UnitUltraSonicIO::uid{"UnitUltraSonicIO"_mmh3};
@@ -49,5 +54,10 @@ bool UnitUltraSonicIO::begin()
     return UnitRCWL9620::begin();
 }
 
+UnitRCWL9620::Interface* UnitUltraSonicIO::create_interface(const Adapter::Type)
+{
+    return make_interface<rcwl9620::InterfaceGPIO>(*this, echoCapture());
+}
+
 }  // namespace unit
 }  // namespace m5
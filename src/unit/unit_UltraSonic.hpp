@@ -11,41 +11,74 @@
 #define M5_UNIT_DISTANCE_UNIT_ULTRA_SONIC_HPP
 
 #include "unit_RCWL9620.hpp"
+#include "rcwl9620/interface.hpp"
 
 namespace m5 {
 namespace unit {
+namespace rcwl9620 {
+///@cond
+// Storage of the fixed interface, constructed before UnitRCWL9620 and destructed after it (base-from-member)
+template <class I>
+struct InterfaceStorage {
+    alignas(I) uint8_t interface_storage[sizeof(I)]{};
+};
+///@endcond
+}  // namespace rcwl9620
 
 /*!
   @class m5::unit::UnitUltraSonicI2C
   @brief An ultrasonic distance measuring sensor unit for I2C
+  @details The interface is stored in the object itself
 */
-class UnitUltraSonicI2C : public UnitRCWL9620 {
+class UnitUltraSonicI2C : private rcwl9620::InterfaceStorage<rcwl9620::InterfaceI2C>, public UnitRCWL9620 {
     M5_UNIT_COMPONENT_HPP_BUILDER(UnitUltraSonicI2C, 0x57);
+    using storage_t = rcwl9620::InterfaceStorage<rcwl9620::InterfaceI2C>;
 
 public:
-    explicit UnitUltraSonicI2C() : UnitRCWL9620(DEFAULT_ADDRESS)
+    explicit UnitUltraSonicI2C()
+        : storage_t(),
+          UnitRCWL9620(DEFAULT_ADDRESS, nullptr, this->interface_storage, sizeof(this->interface_storage))
+    {
+    }
+    virtual ~UnitUltraSonicI2C()
     {
+        release();
     }
     virtual bool begin() override;
+
+protected:
+    // Always I2C
+    virtual Interface* create_interface(const Adapter::Type) override;
 };
 
 /*!
   @class m5::unit::UnitUltraSonicIO
   @brief An ultrasonic distance measuring sensor unit for GPIO
+  @details The interface is stored in the object itself
 */
-class UnitUltraSonicIO : public UnitRCWL9620 {
+class UnitUltraSonicIO : private rcwl9620::InterfaceStorage<rcwl9620::InterfaceGPIO>, public UnitRCWL9620 {
     M5_UNIT_COMPONENT_HPP_BUILDER(UnitUltraSonicIO, 0x00);
+    using storage_t = rcwl9620::InterfaceStorage<rcwl9620::InterfaceGPIO>;
 
 public:
-    explicit UnitUltraSonicIO() : UnitRCWL9620(DEFAULT_ADDRESS)
+    explicit UnitUltraSonicIO()
+        : storage_t(),
+          UnitRCWL9620(DEFAULT_ADDRESS, nullptr, this->interface_storage, sizeof(this->interface_storage))
+    {
+    }
+    virtual ~UnitUltraSonicIO()
     {
+        release();
     }
     virtual bool begin() override;
 
 protected:
-    inline virtual uint32_t minimum_interval() const
+    // Always GPIO
+    virtual Interface* create_interface(const Adapter::Type) override;
+    // Derived from the echo timeout (50 ms for the full range)
+    inline virtual uint32_t minimum_interval() const override
     {
-        return 50;
+        return rcwl9620::minimum_interval_ms(echoTimeout_us());
     }
 };
 
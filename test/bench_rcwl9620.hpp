@@ -0,0 +1,452 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Microbenchmark of UnitRCWL9620 for native and embedded
+  Each result is printed as one line of JSON prefixed by "BENCH ", e.g.
+  BENCH {"bench":"update_idle","interface":"I2C","stored_size":8,"iterations":20000,"ns_per_op":41.2}
+  Benches of the output also print "bytes_per_op"
+  Sizes of the types are printed as
+  BENCH {"bench":"sizeof","type":"UnitRCWL9620","bytes":312}
+*/
+#ifndef M5_UNIT_DISTANCE_TEST_BENCH_RCWL9620_HPP
+#define M5_UNIT_DISTANCE_TEST_BENCH_RCWL9620_HPP
+
+#include "sim_rcwl9620.hpp"
+#include <unit/unit_RCWL9620_static.hpp>
+#include <unit/unit_UltraSonic.hpp>
+#include <unit/rcwl9620/telemetry.hpp>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+namespace bench {
+
+struct result_t {
+    const char* bench{};
+    const char* interface{};
+    uint32_t stored_size{};
+    uint32_t iterations{};
+    uint32_t elapsed_us{};
+    uint32_t bytes{};  // Output bytes if the bench is of the output
+
+    inline float ns_per_op() const
+    {
+        return iterations ? elapsed_us * 1000.f / iterations : 0.f;
+    }
+    inline float bytes_per_op() const
+    {
+        return iterations ? (float)bytes / iterations : 0.f;
+    }
+};
+
+inline void print(const result_t& r)
+{
+    printf("BENCH {\"bench\":\"%s\",\"interface\":\"%s\",\"stored_size\":%u,\"iterations\":%u,\"ns_per_op\":%.1f",
+           r.bench, r.interface, r.stored_size, r.iterations, r.ns_per_op());
+    if (r.bytes) {
+        printf(",\"bytes_per_op\":%.2f", r.bytes_per_op());
+    }
+    printf("}\n");
+    fflush(stdout);
+}
+
+template <typename F>
+result_t measure(const char* bench, const char* interface, const uint32_t stored, const uint32_t iterations, F&& f)
+{
+    result_t r{};
+    r.bench       = bench;
+    r.interface   = interface;
+    r.stored_size = stored;
+    r.iterations  = iterations;
+    auto start    = m5::utility::micros();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    r.elapsed_us = m5::utility::micros() - start;
+    print(r);
+    return r;
+}
+
+// F returns the output bytes
+template <typename F>
+result_t measure_output(const char* bench, const uint32_t iterations, F&& f)
+{
+    result_t r{};
+    r.bench      = bench;
+    r.interface  = "-";
+    r.iterations = iterations;
+    auto start   = m5::utility::micros();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        r.bytes += f();
+    }
+    r.elapsed_us = m5::utility::micros() - start;
+    print(r);
+    return r;
+}
+
+inline void print_size(const char* type, const size_t bytes)
+{
+    printf("BENCH {\"bench\":\"sizeof\",\"type\":\"%s\",\"bytes\":%u}\n", type, (unsigned)bytes);
+    fflush(stdout);
+}
+
+inline void yield_task()
+{
+#if defined(ESP_PLATFORM)
+    taskYIELD();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+inline const char* interface_name(const Adapter::Type type)
+{
+    return type == Adapter::Type::GPIO ? "GPIO" : "I2C";
+}
+
+// Nothing is due
+inline result_t update_idle(const Adapter::Type type, const uint32_t stored, const uint32_t iterations)
+{
+    SimRCWL9620 dev;
+    SimDeviceUnit unit(dev, type, stored);
+    unit.begin();
+    unit.startPeriodicMeasurement(60 * 1000U);
+    return measure("update_idle", interface_name(type), stored, iterations, [&unit]() { unit.update(); });
+}
+
+// Read completes and the next request is issued on each call
+inline result_t update_complete(const Adapter::Type type, const uint32_t stored, const uint32_t iterations)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000});
+    SimDeviceUnit unit(dev, type, stored);
+    unit.begin();
+    unit.startPeriodicMeasurement(1);
+    return measure("update_complete", interface_name(type), stored, iterations, [&unit]() { unit.update(true); });
+}
+
+// Read gives up on each call (I2C: deadline exceeded, GPIO: no echo)
+inline result_t update_timeout(const Adapter::Type type, const uint32_t stored, const uint32_t iterations)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.nacks   = 0xFFFFFFFFU;
+    scfg.no_echo = true;
+    SimRCWL9620 dev(scfg);
+    SimDeviceUnit unit(dev, type, stored);
+    auto cfg                  = unit.config();
+    cfg.readiness.deadline_ms = 0;
+    unit.config(cfg);
+    unit.begin();
+    unit.startPeriodicMeasurement(1);
+    return measure("update_timeout", interface_name(type), stored, iterations, [&unit]() { unit.update(true); });
+}
+
+// Conversion of the stored data
+inline result_t distance(const uint32_t iterations)
+{
+    Data samples[16]{};
+    uint32_t um{};
+    for (auto&& s : samples) {
+        um += 277777;
+        s.raw = {(uint8_t)(um >> 16), (uint8_t)(um >> 8), (uint8_t)um};
+    }
+    volatile float sum{};
+    uint32_t i{};
+    return measure("distance", "-", 0, iterations, [&]() { sum = sum + samples[i++ & 0x0F].distance(); });
+}
+
+// Integer conversion of the stored data
+inline result_t distance_u16(const uint32_t iterations)
+{
+    Data samples[16]{};
+    uint32_t um{};
+    for (auto&& s : samples) {
+        um += 277777;
+        s.raw = {(uint8_t)(um >> 16), (uint8_t)(um >> 8), (uint8_t)um};
+    }
+    volatile uint32_t sum{};
+    uint32_t i{};
+    return measure("distance_u16", "-", 0, iterations, [&]() { sum = sum + samples[i++ & 0x0F].distance_mm_u16(); });
+}
+
+// Echo pulse width to the distance (GPIO)
+inline result_t time_of_flight(const uint32_t iterations)
+{
+    volatile uint32_t sum{};
+    uint32_t i{};
+    return measure("time_of_flight", "-", 0, iterations, [&]() { sum = sum + tof_to_um(116 + (i++ & 0x3FFF)); });
+}
+
+// Reference of time_of_flight by the float
+inline result_t time_of_flight_float(const uint32_t iterations)
+{
+    volatile uint32_t sum{};
+    uint32_t i{};
+    return measure("time_of_flight_float", "-", 0, iterations, [&]() {
+        const uint32_t us = 116 + (i++ & 0x3FFF);
+        const uint32_t mm = static_cast<uint32_t>(us * 0.343f / 2.0f);
+        sum               = sum + static_cast<uint32_t>(mm * 1000.0f);
+    });
+}
+
+// Median, outlier gate and EMA over the window
+inline result_t filter(const uint8_t window, const uint32_t iterations)
+{
+    Filter::config_t cfg{};
+    cfg.window    = window;
+    cfg.median    = true;
+    cfg.outlier_k = 30;
+    cfg.ema_alpha = 32;
+    Filter f(cfg);
+    uint32_t seed{1};
+    volatile uint32_t sum{};
+    bool outlier{};
+    return measure("filter", "-", window, iterations, [&]() {
+        seed = seed * 1664525U + 1013904223U;
+        sum  = sum + f.apply(20000 + (seed >> 8) % 4480000, outlier);
+    });
+}
+
+// Velocity estimation
+inline result_t motion(const uint32_t iterations)
+{
+    Motion::config_t cfg{};
+    cfg.alpha = 128;
+    cfg.beta  = 32;
+    Motion m(cfg);
+    uint32_t um{2000000}, at{};
+    volatile float sum{};
+    return measure("motion", "-", 0, iterations, [&]() {
+        um = um > 100000 ? um - 1000 : 2000000;
+        at += 20000;
+        m.update(um, at);
+        sum = sum + m.velocity_mm_s();
+    });
+}
+
+// Stationary target about 1m with the noise of a few mm
+inline Data noisy_sample(uint32_t& seed)
+{
+    seed              = seed * 1664525U + 1013904223U;
+    const uint32_t um = 1000000 + ((seed >> 8) % 6000) - 3000;
+    Data d{};
+    d.raw = {(uint8_t)(um >> 16), (uint8_t)(um >> 8), (uint8_t)um};
+    return d;
+}
+
+// Each sample as the text of the examples
+inline result_t output_text(const uint32_t iterations)
+{
+    uint32_t seed{};
+    char buf[128]{};
+    return measure_output("output_text", iterations, [&]() -> uint32_t {
+        const Data d = noisy_sample(seed);
+        return snprintf(buf, sizeof(buf), ">%s_Distance:%f\n>%s_Raw:%u\n", "I2C", d.distance(), "I2C",
+                        (unsigned)d.raw_distance());
+    });
+}
+
+// Samples as the binary telemetry, a frame per 16 samples
+inline result_t output_binary(const uint32_t iterations)
+{
+    uint32_t seed{};
+    uint8_t buf[telemetry::max_frame_size(16)]{};
+    telemetry::Encoder enc(buf, sizeof(buf));
+    telemetry::header_t h{};
+    h.interval_ms = 150;
+    enc.begin(h);
+    return measure_output("output_binary", iterations, [&]() -> uint32_t {
+        enc.push(noisy_sample(seed).raw_distance());
+        if (enc.count() < 16) {
+            return 0;
+        }
+        const uint32_t len = enc.finish();
+        h.timestamp_ms += 16 * h.interval_ms;
+        enc.begin(h);
+        return len;
+    });
+}
+
+// Push to the full buffer
+inline result_t push(const uint32_t stored, const uint32_t iterations)
+{
+    RingBuffer<Data> rb(stored);
+    Data d{};
+    uint8_t v{};
+    return measure("push", "-", stored, iterations, [&]() {
+        d.raw[2] = ++v;
+        rb.push_back(d);
+    });
+}
+
+// Zone crossing over all the zones
+inline result_t zones(const uint32_t iterations)
+{
+    Zones z;
+    for (uint8_t i = 0; i < Zones::MAX_ZONES; ++i) {
+        Zones::zone_t zt{};
+        zt.near_um       = i * 400000U;
+        zt.far_um        = (i + 1) * 400000U;
+        zt.hysteresis_um = 10000;
+        z.add(zt);
+    }
+    uint32_t i{};
+    return measure("zones", "-", Zones::MAX_ZONES, iterations, [&]() { z.update(20000 + (i++ & 0x3FF) * 4000); });
+}
+
+// Unit filled with the data without the measurement
+class FilledUnit : public SimDeviceUnit {
+public:
+    FilledUnit(SimRCWL9620& dev, const uint32_t stored) : SimDeviceUnit(dev, Adapter::Type::I2C, stored)
+    {
+    }
+    void fill(const uint32_t num)
+    {
+        Data d{};
+        for (uint32_t i = 0; i < num; ++i) {
+            d.raw[2] = i;
+            store_measurement(d);
+        }
+    }
+};
+
+// Read all the wrapped data of the unit by oldest() and discard() (drain=false) or by drain()
+inline result_t read_all(const bool drain, const uint32_t stored, const uint32_t iterations)
+{
+    SimRCWL9620 dev;
+    FilledUnit unit(dev, stored);
+    unit.begin();
+    std::vector<Data> out(stored);
+    volatile uint32_t sum{};
+    result_t r{};
+    r.bench       = drain ? "drain" : "read_loop";
+    r.interface   = "-";
+    r.stored_size = stored;
+    r.iterations  = iterations;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        unit.fill(stored + stored / 2);
+        const auto start = m5::utility::micros();
+        if (drain) {
+            const size_t n = unit.drain(out.data(), out.size());
+            for (size_t j = 0; j < n; ++j) {
+                sum = sum + out[j].raw[2];
+            }
+        } else {
+            while (!unit.empty()) {
+                sum = sum + unit.oldest().raw[2];
+                unit.discard();
+            }
+        }
+        r.elapsed_us += m5::utility::micros() - start;
+    }
+    print(r);
+    return r;
+}
+
+// Throughput of the lock-free buffer, produced in the task and consumed in the caller
+inline result_t spsc(const uint32_t stored, const uint32_t iterations)
+{
+    RingBuffer<Data> q(stored, false);
+    Worker producer;
+    uint32_t pushed{};
+    Data out[32]{};
+    volatile uint32_t sum{};
+    result_t r{};
+    r.bench       = "spsc_throughput";
+    r.interface   = "-";
+    r.stored_size = stored;
+    r.iterations  = iterations;
+    const auto start = m5::utility::micros();
+    producer.start([&q, &pushed, iterations](uint32_t&) {
+        Data d{};
+        while (pushed < iterations) {
+            d.raw[2] = pushed;
+            if (!q.push_back(d)) {
+                return true;  // Yield
+            }
+            ++pushed;
+        }
+        return false;
+    });
+    for (uint32_t cnt = 0; cnt < iterations;) {
+        const size_t n = q.drain(out, 32);
+        for (size_t i = 0; i < n; ++i) {
+            sum = sum + out[i].raw[2];
+        }
+        cnt += n;
+        if (!n) {
+            yield_task();
+        }
+    }
+    r.elapsed_us = m5::utility::micros() - start;
+    producer.stop();
+    print(r);
+    return r;
+}
+
+// Footprint of the unit and the storage
+inline void sizes()
+{
+    print_size("UnitRCWL9620", sizeof(UnitRCWL9620));
+    print_size("UnitRCWL9620Static<8>", sizeof(UnitRCWL9620Static<8>));
+    print_size("UnitUltraSonicI2C", sizeof(UnitUltraSonicI2C));
+    print_size("UnitUltraSonicIO", sizeof(UnitUltraSonicIO));
+    print_size("RingBuffer<Data>", sizeof(RingBuffer<Data>));
+    print_size("InterfaceI2C", sizeof(InterfaceI2C));
+    print_size("InterfaceGPIO", sizeof(InterfaceGPIO));
+}
+
+// All the cases
+inline std::vector<result_t> run(const uint32_t iterations)
+{
+    std::vector<result_t> results{};
+    sizes();
+    results.push_back(distance(iterations));
+    results.push_back(distance_u16(iterations));
+    results.push_back(time_of_flight(iterations));
+    results.push_back(time_of_flight_float(iterations));
+    results.push_back(motion(iterations));
+    results.push_back(zones(iterations));
+    results.push_back(output_text(iterations));
+    results.push_back(output_binary(iterations));
+    for (uint8_t w = 3; w <= Filter::MAX_WINDOW; w += 4) {
+        results.push_back(filter(w, iterations));
+    }
+    for (auto&& stored : {8U, 64U, 256U, 1024U, 4096U}) {
+        // Each iteration fills and reads all the stored data, so fewer for the larger
+        const uint32_t n = std::max<uint32_t>(1U, iterations * 4U / stored);
+        results.push_back(read_all(false, stored, n));
+        results.push_back(read_all(true, stored, n));
+    }
+    for (auto&& stored : {1U, 8U, 64U, 256U}) {
+        results.push_back(push(stored, iterations));
+        results.push_back(spsc(stored, iterations));
+        // The waits of both interfaces only advance the simulated clock
+        for (auto&& type : {Adapter::Type::I2C, Adapter::Type::GPIO}) {
+            results.push_back(update_idle(type, stored, iterations));
+            results.push_back(update_complete(type, stored, iterations));
+            results.push_back(update_timeout(type, stored, iterations));
+        }
+    }
+    return results;
+}
+
+}  // namespace bench
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Benchmark for UnitRCWL9620 on embedded
+  The simulated unit is used, so the unit need not be connected
+*/
+#include <gtest/gtest.h>
+#include <M5Unified.h>
+#include "../../bench_rcwl9620.hpp"
+
+using namespace m5::unit;
+using namespace m5::unit::rcwl9620;
+
+TEST(RCWL9620Bench, Update)
+{
+    auto results = bench::run(2000);
+    EXPECT_EQ(results.size(), 8U + 4U + 5U * 2U + 4U * (2U + 2U * 3U));
+    for (auto&& r : results) {
+        EXPECT_GT(r.iterations, 0U) << r.bench;
+    }
+}
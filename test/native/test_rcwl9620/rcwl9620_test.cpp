@@ -0,0 +1,2296 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for UnitRCWL9620 on native
+*/
+#include <gtest/gtest.h>
+#include <M5Utility.hpp>
+#include <unit/unit_RCWL9620.hpp>
+#include <unit/unit_RCWL9620_static.hpp>
+#include <unit/unit_UltraSonic.hpp>
+#include <unit/rcwl9620/scheduler.hpp>
+#include <unit/rcwl9620/pacer.hpp>
+#include <unit/rcwl9620/telemetry.hpp>
+#include "../../sim_rcwl9620.hpp"
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <utility>
+
+using namespace m5::unit;
+using namespace m5::unit::rcwl9620;
+using m5::unit::types::elapsed_time_t;
+
+// Count the heap allocations
+namespace {
+std::atomic<uint32_t> allocations{};
+}  // namespace
+void* operator new(size_t sz)
+{
+    ++allocations;
+    if (void* p = std::malloc(sz ? sz : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new(size_t sz, const std::nothrow_t&) noexcept
+{
+    ++allocations;
+    return std::malloc(sz ? sz : 1);
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+// Unit using the GPIO interface without the real pins
+class GPIOUnit : public UnitRCWL9620 {
+public:
+    GPIOUnit() : UnitRCWL9620()
+    {
+        auto cfg           = config();
+        cfg.start_periodic = false;
+        config(cfg);
+    }
+
+protected:
+    virtual Interface* create_interface(const Adapter::Type) override
+    {
+        return UnitRCWL9620::create_interface(Adapter::Type::GPIO);
+    }
+};
+
+// Simulated echo pin source that drives the capture
+class SimEchoCapture : public EchoCapture {
+public:
+    virtual bool begin() override
+    {
+        ++begun;
+        return true;
+    }
+    // Echo pulse of the width (us) after the trigger
+    void echo(const uint32_t width)
+    {
+        auto at = armedAt() + 500;
+        edge(true, at);
+        edge(false, at + width);
+    }
+    uint32_t begun{};
+};
+
+}  // namespace
+
+TEST(RCWL9620, SingleshotNonBlocking)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 20 * 1000;
+    scfg.nacks      = 3;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000});
+    auto& clock = dev.fakeClock();
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_FALSE(unit.inPeriodic());
+
+    bool ret = unit.requestSingleshot();
+    EXPECT_TRUE(ret);
+    EXPECT_TRUE(unit.inSingleshot());
+    EXPECT_FALSE(unit.requestSingleshot());               // Already requested
+    EXPECT_FALSE(unit.startPeriodicMeasurement(1000U));  // Singleshot is pending
+
+    Data d{};
+    uint32_t polls{};
+    auto timeout_at = clock.millis() + 1000;
+    while (!ret || unit.inSingleshot()) {
+        ASSERT_LT(clock.millis(), timeout_at);
+        ret = unit.singleshotReady() && unit.pollSingleshot(d);
+        ++polls;
+        clock.advance(1000);
+    }
+    EXPECT_TRUE(ret);
+    EXPECT_GT(polls, 1U);
+    EXPECT_EQ(clock.waits, 0U);  // Never waits
+    EXPECT_EQ(dev.writes, 1U);
+    EXPECT_EQ(dev.reads, 4U);  // 3 NACKs and success
+    EXPECT_FALSE(unit.inSingleshot());
+    EXPECT_EQ(d.raw_distance(), 100000U);
+    EXPECT_FLOAT_EQ(d.distance(), 100.f);
+}
+
+TEST(RCWL9620, SingleshotCallback)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    scfg.nacks      = 2;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000});
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+
+    uint32_t called{};
+    Data result{};
+    bool valid{};
+    EXPECT_TRUE(unit.requestSingleshot([&](UnitRCWL9620&, const Data& d, const bool v) {
+        ++called;
+        result = d;
+        valid  = v;
+    }));
+
+    // Backoff between the NACKed reads
+    uint32_t cnt{8};
+    while (cnt--) {
+        unit.update();
+        dev.fakeClock().advance(1000);
+    }
+    EXPECT_EQ(called, 1U);
+    EXPECT_TRUE(valid);
+    EXPECT_EQ(result.raw_distance(), 100000U);
+    EXPECT_FALSE(unit.inSingleshot());
+
+    // Blocking API is still available
+    Data d{};
+    EXPECT_TRUE(unit.measureSingleshot(d));
+    EXPECT_EQ(d.raw_distance(), 100000U);
+}
+
+TEST(RCWL9620, SingleshotGPIO)
+{
+    // Without the capture, the request is deferred and the completion triggers and measures the echo
+    SimRCWL9620 dev{};
+    dev.trace({100000, 200000});
+    SimDeviceUnit unit(dev, Adapter::Type::GPIO);
+    ASSERT_TRUE(unit.begin());
+
+    Data d{};
+    EXPECT_TRUE(unit.requestSingleshot());
+    EXPECT_EQ(dev.writes, 0U);
+    EXPECT_TRUE(unit.singleshotReady());  // No ranging time
+    EXPECT_TRUE(unit.pollSingleshot(d));
+    EXPECT_GT(dev.fakeClock().waits, 0U);  // Trigger pulse and the echo
+    EXPECT_EQ(dev.writes, 1U);
+    EXPECT_EQ(dev.reads, 1U);
+    EXPECT_FALSE(unit.inSingleshot());
+    EXPECT_NEAR(d.raw_distance(), 100000U, 200U);
+
+    uint32_t called{};
+    EXPECT_TRUE(unit.requestSingleshot([&](UnitRCWL9620&, const Data& data, const bool valid) {
+        ++called;
+        d = data;
+        EXPECT_TRUE(valid);
+    }));
+    unit.update();
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(dev.writes, 2U);
+    EXPECT_NEAR(d.raw_distance(), 200000U, 200U);
+
+    // No echo
+    auto cfg    = dev.config();
+    cfg.no_echo = true;
+    dev.config(cfg);
+    EXPECT_TRUE(unit.requestSingleshot());
+    EXPECT_FALSE(unit.pollSingleshot(d));
+    EXPECT_EQ(dev.nacked, 1U);
+}
+
+TEST(RCWL9620, EchoCapture)
+{
+    EchoCapture cap;
+    EXPECT_EQ(cap.state(), EchoCapture::State::Idle);
+
+    // Edges before arming are ignored
+    cap.edge(true, 100);
+    cap.edge(false, 200);
+    EXPECT_FALSE(cap.captured());
+
+    cap.arm(1000);
+    EXPECT_EQ(cap.state(), EchoCapture::State::Armed);
+    cap.edge(false, 1100);  // Ignored
+    EXPECT_EQ(cap.state(), EchoCapture::State::Armed);
+    cap.edge(true, 1500);
+    EXPECT_EQ(cap.state(), EchoCapture::State::Rising);
+    cap.edge(true, 1600);  // Ignored
+    cap.edge(false, 7331);
+    EXPECT_TRUE(cap.captured());
+    EXPECT_EQ(cap.duration(), 5831U);
+
+    // Wrap around of micros
+    cap.arm(0xFFFFFF00U);
+    cap.edge(true, 0xFFFFFFF0U);
+    cap.edge(false, 0x00000010U);
+    EXPECT_TRUE(cap.captured());
+    EXPECT_EQ(cap.duration(), 0x20U);
+
+    cap.disarm();
+    EXPECT_EQ(cap.state(), EchoCapture::State::Idle);
+}
+
+TEST(RCWL9620, GPIOCapture)
+{
+    GPIOUnit unit;
+    SimEchoCapture cap;
+    unit.attachEchoCapture(&cap);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_EQ(cap.begun, 1U);
+
+    // Singleshot
+    Data d{};
+    EXPECT_TRUE(unit.requestSingleshot());
+    EXPECT_EQ(cap.state(), EchoCapture::State::Armed);
+    EXPECT_FALSE(unit.pollSingleshot(d));  // Echo is not yet
+    EXPECT_TRUE(unit.inSingleshot());
+    cap.echo(5831);  // 1000 mm
+    EXPECT_TRUE(unit.pollSingleshot(d));
+    EXPECT_EQ(d.raw_distance(), 1000016U);
+    EXPECT_FALSE(unit.inSingleshot());
+
+    // Periodic, update() does not wait for the echo
+    EXPECT_TRUE(unit.startPeriodicMeasurement(150U));
+    EXPECT_EQ(cap.state(), EchoCapture::State::Armed);
+
+    uint32_t cnt{4};
+    while (cnt--) {
+        unit.update(true);
+        EXPECT_FALSE(unit.updated());
+    }
+
+    cap.echo(2915);  // 499.922 mm
+    unit.update(true);
+    EXPECT_TRUE(unit.updated());
+    EXPECT_EQ(cap.state(), EchoCapture::State::Armed);  // Triggered again
+    EXPECT_EQ(unit.available(), 1U);
+    EXPECT_EQ(unit.oldest().raw_distance(), 499922U);
+}
+
+TEST(RCWL9620, IntegerDistance)
+{
+    static_assert(Data::clamp_um(0) == Data::MIN_DISTANCE_UM, "Invalid clamp");
+    static_assert(Data::clamp_um(0xFFFFFF) == Data::MAX_DISTANCE_UM, "Invalid clamp");
+    static_assert(Data::to_mm_u16(123456) == 123, "Invalid conversion");
+
+    // Bit-exact with the float path over the whole raw range
+    Data d{};
+    uint32_t mismatch{};
+    for (uint32_t um = 0; um <= 0xFFFFFF; ++um) {
+        d.raw = {(uint8_t)(um >> 16), (uint8_t)(um >> 8), (uint8_t)um};
+        const float fd = std::fmax(std::fmin(um / 1000.f, Data::MAX_DISTANCE), Data::MIN_DISTANCE);
+        mismatch += (d.distance() != fd) || (d.distance_mm_u16() != static_cast<uint16_t>(fd)) ||
+                    (d.distance_um() / 1000.f != fd);
+    }
+    EXPECT_EQ(mismatch, 0U);
+}
+
+TEST(RCWL9620, TimeOfFlight)
+{
+    static_assert(tof_to_um(5831) == 1000016U, "Invalid conversion");
+    static_assert(tof_to_um(0xFFFFFFFFU) == 0xFFFFFFU, "Not saturated");
+    static_assert(speed_of_sound(20.f) == 34359U, "Invalid speed");
+
+    // Against the previous float path (truncated to mm) for 20 - 4500 mm
+    uint32_t boundary{};
+    for (uint32_t us = 116; us <= 26240; ++us) {
+        const uint32_t prev_mm = static_cast<uint32_t>(us * 0.343f / 2.0f);
+        const uint32_t um      = tof_to_um(us);
+        ASSERT_GE(um / 1000, prev_mm) << us;
+        ASSERT_LE(um / 1000 - prev_mm, 1U) << us;
+        if (um / 1000 != prev_mm) {
+            // Float rounding just below the exact mm boundary
+            EXPECT_EQ(us * 1715U % 10000U, 0U) << us;
+            ++boundary;
+        }
+        // Sub mm resolution is kept
+        EXPECT_EQ(um, us * 1715U / 10U) << us;
+    }
+    EXPECT_LT(boundary, 16U);
+
+    // Temperature
+    EXPECT_LT(tof_to_um(5831, speed_of_sound(-10.f)), tof_to_um(5831, speed_of_sound(30.f)));
+
+    GPIOUnit unit;
+    SimEchoCapture cap;
+    unit.attachEchoCapture(&cap);
+    EXPECT_EQ(unit.speedOfSound(), SPEED_OF_SOUND);
+    unit.speedOfSound(speed_of_sound(0.f));
+    ASSERT_TRUE(unit.begin());
+    Data d{};
+    EXPECT_TRUE(unit.requestSingleshot());
+    cap.echo(5831);
+    EXPECT_TRUE(unit.pollSingleshot(d));
+    EXPECT_EQ(d.raw_distance(), tof_to_um(5831, 33145));
+}
+
+namespace {
+
+// Device on the bus, ready after the ranging time (ms)
+SimRCWL9620::config_t bus_config(const uint32_t ranging_ms)
+{
+    SimRCWL9620::config_t cfg{};
+    cfg.latency_us     = ranging_ms * 1000U;
+    cfg.record_windows = true;
+    return cfg;
+}
+
+// Devices on the same bus and the units, on the same clock
+template <size_t N>
+struct SimBus {
+    explicit SimBus(const uint32_t ranging_ms)
+    {
+        for (size_t i = 0; i < N; ++i) {
+            devices[i].config(bus_config(ranging_ms));
+            devices[i].attachClock(&clock);
+            devices[i].trace({10000U + (uint32_t)i});
+            units[i].reset(new SimDeviceUnit(devices[i], Adapter::Type::I2C, 64));
+        }
+    }
+    std::vector<const SimRCWL9620*> devs() const
+    {
+        std::vector<const SimRCWL9620*> v{};
+        for (auto&& d : devices) {
+            v.push_back(&d);
+        }
+        return v;
+    }
+
+    FakeClock clock{};
+    SimRCWL9620 devices[N]{};
+    std::unique_ptr<SimDeviceUnit> units[N]{};
+};
+
+// Proceed the schedule for the simulated time
+void run_scheduler(Scheduler& sch, FakeClock& clock, const uint32_t ms)
+{
+    auto timeout_at = clock.millis() + ms;
+    while (clock.millis() < timeout_at) {
+        sch.update();
+        clock.advance(100);
+    }
+}
+
+}  // namespace
+
+TEST(RCWL9620, Scheduler)
+{
+    SimBus<3> bus(10);
+    auto& u0 = *bus.units[0];
+    auto& u1 = *bus.units[1];
+    auto& u2 = *bus.units[2];
+    for (auto&& u : bus.units) {
+        ASSERT_TRUE(u->begin());
+    }
+
+    Scheduler sch;
+    EXPECT_FALSE(sch.start());  // No units
+    EXPECT_TRUE(sch.add(u0));
+    EXPECT_FALSE(sch.add(u0));  // Already added
+    EXPECT_TRUE(sch.add(u1));
+    EXPECT_TRUE(sch.add(u2));
+    EXPECT_EQ(u1.scheduler(), &sch);
+
+    EXPECT_TRUE(sch.start());
+    EXPECT_TRUE(sch.running());
+    EXPECT_TRUE(u0.inPeriodic());
+    EXPECT_FALSE(u0.stopPeriodicMeasurement());  // Owned by the scheduler
+    EXPECT_EQ(sch.slotTime(), 10U);
+    EXPECT_EQ(sch.groups(), 3U);
+    EXPECT_EQ(sch.cycleTime(), 30U);
+    EXPECT_EQ(sch.offset(0), 0U);
+    EXPECT_EQ(sch.offset(1), 10U);
+    EXPECT_EQ(sch.offset(2), 20U);
+    EXPECT_EQ(u2.interval(), 30U);
+
+    run_scheduler(sch, bus.clock, 300);
+    sch.stop();
+    EXPECT_FALSE(sch.running());
+    EXPECT_FALSE(u0.inPeriodic());
+
+    // Round robin without overlap of the pings
+    EXPECT_EQ(max_overlap(bus.devs()), 1U);
+    auto windows = bus_windows(bus.devs());
+    // Read in the next slot, so 1 slot less than the elapsed
+    ASSERT_EQ(windows.size(), 29U);
+    for (size_t i = 0; i < windows.size(); ++i) {
+        EXPECT_EQ(windows[i].device, i % 3) << i;
+    }
+    EXPECT_EQ(sch.samples(), windows.size());
+    EXPECT_EQ(sch.errors(), 0U);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_GE(bus.units[i]->available(), windows.size() / 3);
+        EXPECT_EQ(bus.units[i]->oldest().raw_distance(), 10000U + i);
+    }
+
+    sch.clear();
+    EXPECT_EQ(u0.scheduler(), nullptr);
+    EXPECT_TRUE(u0.startPeriodicMeasurement(150U));
+
+    // All the units must use the same clock
+    SimRCWL9620 other_dev{};
+    SimDeviceUnit other(other_dev);
+    ASSERT_TRUE(other.begin());
+    EXPECT_TRUE(sch.add(u1));
+    EXPECT_FALSE(sch.add(other));
+}
+
+TEST(RCWL9620, SchedulerConcurrency)
+{
+    SimBus<4> bus(10);
+
+    Scheduler sch;
+    auto cfg        = sch.config();
+    cfg.slot_ms     = 20;
+    cfg.concurrency = 2;
+    sch.config(cfg);
+    for (auto&& u : bus.units) {
+        ASSERT_TRUE(u->begin());
+        EXPECT_TRUE(sch.add(*u));
+    }
+    EXPECT_TRUE(sch.start());
+    EXPECT_EQ(sch.slotTime(), 20U);
+    EXPECT_EQ(sch.groups(), 2U);
+    EXPECT_EQ(sch.group(1), 0U);
+    EXPECT_EQ(sch.group(2), 1U);
+
+    run_scheduler(sch, bus.clock, 400);
+    sch.stop();
+
+    EXPECT_EQ(max_overlap(bus.devs()), 2U);
+    // 2 samples per 20 ms slot, read in the next slot
+    EXPECT_EQ(sch.samples(), 38U);
+    EXPECT_FLOAT_EQ(sch.samplesPerSecond(), 95.f);
+    for (auto&& u : bus.units) {
+        EXPECT_GE(u->available(), 7U);
+    }
+    // Command and read of each sample at least
+    uint32_t transactions{};
+    for (auto&& d : bus.devices) {
+        transactions += d.transactions();
+    }
+    EXPECT_GE(transactions, sch.samples() * 2);
+}
+
+TEST(RCWL9620, Timestamp)
+{
+    static_assert(sizeof(Timestamp) == 8, "Timestamp must be compact");
+
+    SimRCWL9620 plain_dev(bus_config(5));
+    SimDeviceUnit plain(plain_dev);
+    ASSERT_TRUE(plain.begin());
+    EXPECT_EQ(plain.oldestTimestamp().request_us, 0U);
+
+    SimRCWL9620 dev(bus_config(5));
+    auto& clock = dev.fakeClock();
+    SimDeviceUnit unit(dev);
+    auto cfg      = unit.config();
+    cfg.timestamp = true;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_TRUE(unit.startPeriodicMeasurement(150U));
+
+    std::vector<Timestamp> stamps{};
+    while (stamps.size() < 5) {
+        clock.advance(6 * 1000);
+        unit.update(true);
+        ASSERT_TRUE(unit.updated());
+        auto ts = unit.latestTimestamp();
+        EXPECT_NE(ts.request_us, 0U);
+        EXPECT_GE(ts.latency_us(), 5000U);
+        if (!stamps.empty()) {
+            EXPECT_GE(ts.request_us, stamps.back().read_us);
+        }
+        stamps.push_back(ts);
+    }
+    EXPECT_EQ(unit.available(), 5U);
+
+    // Stays aligned with the data through discard and overwrite
+    auto td = unit.oldestTimed();
+    EXPECT_EQ(td.data.raw_distance(), unit.oldest().raw_distance());
+    EXPECT_EQ(td.timestamp.request_us, stamps[0].request_us);
+    unit.discard();
+    unit.discard();
+    EXPECT_EQ(unit.oldestTimestamp().request_us, stamps[2].request_us);
+    EXPECT_EQ(unit.oldestTimestamp().read_us, stamps[2].read_us);
+    EXPECT_EQ(unit.latestTimestamp().read_us, stamps[4].read_us);
+
+    unit.flush();
+    EXPECT_EQ(unit.oldestTimestamp().request_us, 0U);
+    clock.advance(6 * 1000);
+    unit.update(true);
+    EXPECT_EQ(unit.available(), 1U);
+    EXPECT_EQ(unit.oldestTimestamp().read_us, unit.latestTimestamp().read_us);
+    EXPECT_GT(unit.oldestTimestamp().read_us, stamps[4].read_us);
+}
+
+namespace {
+
+class BulkUnit : public SimDeviceUnit {
+public:
+    BulkUnit(SimRCWL9620& dev, const uint32_t stored, const Filter::config_t& fcfg = Filter::config_t{})
+        : SimDeviceUnit(dev, Adapter::Type::I2C, stored)
+    {
+        auto cfg   = config();
+        cfg.filter = fcfg;
+        config(cfg);
+    }
+    void fill(const uint32_t num, const uint32_t from = 0)
+    {
+        for (uint32_t i = 0; i < num; ++i) {
+            Data d{};
+            const uint32_t v = from + i;
+            d.raw            = {(uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v};
+            store_measurement(d);
+        }
+    }
+};
+
+}  // namespace
+
+TEST(RCWL9620, RingBuffer)
+{
+    RingBuffer<uint32_t> rb(4);
+    uint32_t out[8]{};
+    EXPECT_TRUE(rb.empty());
+    EXPECT_FALSE(rb.front().has_value());
+    EXPECT_EQ(rb.read(out, 8), 0U);
+    EXPECT_EQ(rb.view().size(), 0U);
+
+    for (uint32_t i = 0; i < 6; ++i) {
+        rb.push_back(i);
+    }
+    // 2,3,4,5 wrapped
+    EXPECT_TRUE(rb.full());
+    EXPECT_EQ(rb.front().value(), 2U);
+    EXPECT_EQ(rb.back().value(), 5U);
+    EXPECT_EQ(rb[1], 3U);
+
+    // 5 slots including the empty one
+    auto v = rb.view();
+    ASSERT_EQ(v.first_size, 3U);
+    ASSERT_EQ(v.second_size, 1U);
+    EXPECT_EQ(v.first[0], 2U);
+    EXPECT_EQ(v.first[1], 3U);
+    EXPECT_EQ(v.first[2], 4U);
+    EXPECT_EQ(v.second[0], 5U);
+
+    EXPECT_EQ(rb.read(out, 3), 3U);
+    EXPECT_EQ(out[0], 2U);
+    EXPECT_EQ(out[2], 4U);
+    EXPECT_EQ(rb.size(), 4U);
+
+    EXPECT_EQ(rb.drain(out, 3), 3U);
+    EXPECT_EQ(rb.size(), 1U);
+    EXPECT_EQ(rb.front().value(), 5U);
+    rb.push_back(6);
+    EXPECT_EQ(rb.drain(out, 8), 2U);
+    EXPECT_EQ(out[0], 5U);
+    EXPECT_EQ(out[1], 6U);
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(rb.view().first, nullptr);
+}
+
+TEST(RCWL9620, Drain)
+{
+    SimRCWL9620 dev{};
+    BulkUnit unit(dev, 8);
+    ASSERT_TRUE(unit.begin());
+    unit.fill(11);  // 3 - 10 remain
+    EXPECT_TRUE(unit.full());
+
+    auto v = unit.view();
+    EXPECT_EQ(v.size(), 8U);
+    EXPECT_EQ(v.first[0].raw_distance(), 3U);
+
+    Data out[16]{};
+    EXPECT_EQ(unit.readAll(out, 16), 8U);
+    EXPECT_EQ(unit.available(), 8U);
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(out[i].raw_distance(), 3 + i);
+    }
+
+    EXPECT_EQ(unit.drain(out, 5), 5U);
+    EXPECT_EQ(unit.available(), 3U);
+    EXPECT_EQ(unit.oldest().raw_distance(), 8U);
+    EXPECT_EQ(unit.drain(out, 16), 3U);
+    EXPECT_EQ(out[2].raw_distance(), 10U);
+    EXPECT_TRUE(unit.empty());
+}
+
+TEST(RCWL9620, Filter)
+{
+    Filter::config_t cfg{};
+    cfg.window = 7;
+    cfg.median = true;
+    Filter f(cfg);
+    EXPECT_TRUE(f.enabled());
+
+    // Against brute force
+    std::mt19937 rng(9620);
+    std::uniform_int_distribution<uint32_t> dist(20000, 4500000);
+    std::vector<uint32_t> hist{};
+    bool outlier{};
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const uint32_t v = (i % 5 == 0) ? dist(rng) : 1000000 + (i % 3) * 1000;
+        hist.push_back(v);
+        auto out = f.apply(v, outlier);
+
+        std::vector<uint32_t> win(hist.end() - std::min<size_t>(hist.size(), 7), hist.end());
+        std::sort(win.begin(), win.end());
+        const uint32_t med = win[(win.size() - 1) / 2];
+        std::vector<uint32_t> dev{};
+        for (auto&& w : win) {
+            dev.push_back(w > med ? w - med : med - w);
+        }
+        std::sort(dev.begin(), dev.end());
+        ASSERT_EQ(out, med) << i;
+        ASSERT_EQ(f.median(), med) << i;
+        ASSERT_EQ(f.mad(), dev[(dev.size() - 1) / 2]) << i;
+    }
+
+    // Outlier gate replaces the spike with the median
+    cfg           = Filter::config_t{};
+    cfg.window    = 5;
+    cfg.outlier_k = 30;
+    f.config(cfg);
+    const uint32_t seq[] = {1000000, 1002000, 999000, 1001000, 3500000, 1000500, 998000};
+    for (auto&& v : seq) {
+        auto out = f.apply(v, outlier);
+        if (v == 3500000) {
+            EXPECT_TRUE(outlier);
+            EXPECT_EQ(out, f.median());
+        } else {
+            EXPECT_FALSE(outlier);
+            EXPECT_EQ(out, v);
+        }
+    }
+
+    // EMA
+    cfg           = Filter::config_t{};
+    cfg.ema_alpha = 64;
+    f.config(cfg);
+    EXPECT_TRUE(f.enabled());
+    EXPECT_EQ(f.apply(1000000, outlier), 1000000U);
+    EXPECT_EQ(f.apply(2000000, outlier), 1250000U);
+    EXPECT_EQ(f.apply(2000000, outlier), 1437500U);
+
+    // Window is adjusted to odd and in range
+    cfg        = Filter::config_t{};
+    cfg.window = 100;
+    f.config(cfg);
+    EXPECT_EQ(f.config().window, Filter::MAX_WINDOW);
+    EXPECT_FALSE(f.enabled());
+}
+
+TEST(RCWL9620, FilterOnUpdate)
+{
+    Filter::config_t cfg{};
+    cfg.window    = 5;
+    cfg.outlier_k = 30;
+    cfg.ema_alpha = 256;  // Through
+    SimRCWL9620 dev{};
+    BulkUnit unit(dev, 8, cfg);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_FALSE(std::isfinite(unit.filteredDistance()));
+
+    unit.fill(1, 500000);
+    unit.fill(1, 501000);
+    unit.fill(1, 499000);
+    unit.fill(1, 4000000);  // Spike
+    unit.fill(1, 500500);
+    EXPECT_EQ(unit.available(), 5U);
+    EXPECT_FALSE(unit.latestFiltered().outlier());
+    EXPECT_EQ(unit.latestFiltered().data.distance_um(), 500500U);
+
+    uint32_t outliers{};
+    while (unit.available()) {
+        auto fd = unit.oldestFiltered();
+        outliers += fd.outlier();
+        if (fd.outlier()) {
+            EXPECT_EQ(unit.oldest().raw_distance(), 4000000U);
+            EXPECT_EQ(fd.data.distance_um(), 500000U);  // Median
+        }
+        EXPECT_LT(unit.filteredDistance(), 510.f);
+        unit.discard();
+    }
+    EXPECT_EQ(outliers, 1U);
+}
+
+TEST(RCWL9620, AdaptiveInterval)
+{
+    AdaptiveInterval ai;
+    auto cfg         = ai.config();
+    cfg.min_ms       = 30;
+    cfg.step_down_ms = 5;
+    cfg.step_up_ms   = 10;
+    ai.config(cfg);
+    ai.start(150);
+    EXPECT_EQ(ai.interval(), 150U);
+
+    ai.success(150, true);
+    EXPECT_EQ(ai.interval(), 145U);
+    ai.success(160, false);  // Not the first read
+    EXPECT_EQ(ai.interval(), 145U);
+    ai.failure(145);
+    EXPECT_EQ(ai.interval(), 150U);  // Upper bound
+    for (int i = 0; i < 100; ++i) {
+        ai.success(40, true);
+    }
+    EXPECT_EQ(ai.interval(), 30U);  // Lower bound
+    EXPECT_EQ(ai.latency(), 40U);
+    EXPECT_EQ(ai.successes(), 102U);
+    EXPECT_EQ(ai.failures(), 1U);
+    EXPECT_EQ(ai.histogram()[4], 100U);
+    EXPECT_EQ(ai.histogram()[AdaptiveInterval::BINS - 1], 2U);
+
+    // Not below the minimum interval
+    ai.start(150, 40);
+    EXPECT_EQ(ai.minimum(), 40U);
+    for (int i = 0; i < 100; ++i) {
+        ai.success(20, true);
+    }
+    EXPECT_EQ(ai.interval(), 40U);
+    ai.config(AdaptiveInterval::config_t{});
+    ai.start(150, 150);
+    EXPECT_EQ(ai.minimum(), 150U);
+    ai.success(20, true);
+    EXPECT_EQ(ai.interval(), 150U);
+}
+
+TEST(RCWL9620, AdaptiveIntervalOnUpdate)
+{
+    SimRCWL9620 dev(bus_config(20));  // Ready after 20 ms
+    auto& clock = dev.fakeClock();
+    SimDeviceUnit unit(dev);
+    auto cfg                  = unit.config();
+    cfg.adaptive_interval     = true;
+    cfg.adaptive.min_ms       = 10;
+    cfg.adaptive.step_down_ms = 10;
+    cfg.adaptive.step_up_ms   = 5;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_TRUE(unit.startPeriodicMeasurement(150U));
+    EXPECT_EQ(unit.interval(), 150U);
+
+    uint32_t samples{};
+    auto timeout_at = clock.millis() + 2000;
+    while (clock.millis() < timeout_at) {
+        unit.update();
+        samples += unit.updated();
+        clock.advance(100);
+    }
+    auto& ai = unit.adaptiveInterval();
+    EXPECT_EQ(ai.minimum(), 10U);
+    EXPECT_GE(unit.interval(), 10U);
+    EXPECT_LE(unit.interval(), 40U);
+    EXPECT_GT(ai.failures(), 0U);
+    EXPECT_GE(ai.latency(), 20U);
+    EXPECT_LE(ai.latency(), 40U);
+    EXPECT_GT(ai.histogram()[2] + ai.histogram()[3], 0U);
+    EXPECT_GT(samples, 2000U / 150U * 2);  // Faster than the fixed interval
+
+    // min_ms is raised to the minimum interval of the unit
+    struct SlowUnit : SimDeviceUnit {
+        explicit SlowUnit(SimRCWL9620& d) : SimDeviceUnit(d)
+        {
+        }
+        virtual uint32_t minimum_interval() const override
+        {
+            return 50;
+        }
+    };
+    SlowUnit slow(dev);
+    slow.config(cfg);
+    ASSERT_TRUE(slow.begin());
+    EXPECT_TRUE(slow.startPeriodicMeasurement(150U));
+    EXPECT_EQ(slow.adaptiveInterval().minimum(), 50U);
+    timeout_at = clock.millis() + 2000;
+    while (clock.millis() < timeout_at) {
+        slow.update();
+        clock.advance(100);
+    }
+    EXPECT_EQ(slow.interval(), 50U);
+}
+
+TEST(RCWL9620, Readiness)
+{
+    Readiness r;
+    auto cfg           = r.config();
+    cfg.deadline_ms    = 200;
+    cfg.backoff_min_ms = 2;
+    cfg.backoff_max_ms = 8;
+    r.config(cfg);
+    EXPECT_EQ(r.poll(0), Readiness::State::Read);  // Not requested
+
+    r.requested(1000000);
+    EXPECT_EQ(r.poll(1000000), Readiness::State::Read);
+    r.nacked(1000000);
+    EXPECT_EQ(r.poll(1001999), Readiness::State::Wait);
+    EXPECT_EQ(r.remaining(1001000), 1000U);
+    EXPECT_EQ(r.poll(1002000), Readiness::State::Read);
+    r.nacked(1002000);  // 4ms
+    EXPECT_EQ(r.poll(1005999), Readiness::State::Wait);
+    r.nacked(1006000);  // 8ms
+    r.nacked(1014000);  // 8ms (max)
+    EXPECT_EQ(r.poll(1021999), Readiness::State::Wait);
+    EXPECT_EQ(r.poll(1022000), Readiness::State::Read);
+    r.acked();
+
+    auto c = r.counters();
+    EXPECT_EQ(c.reads, 5U);
+    EXPECT_EQ(c.nacks, 4U);
+    EXPECT_EQ(c.retries, 4U);
+    EXPECT_EQ(c.dropped, 0U);
+
+    // Deadline, with the wrap around of micros
+    r.requested(0xFFFFFF00U);
+    r.nacked(0xFFFFFF00U);
+    EXPECT_EQ(r.poll(0x00000100U), Readiness::State::Wait);
+    EXPECT_EQ(r.poll(0xFFFFFF00U + 2000), Readiness::State::Read);
+    EXPECT_EQ(r.poll(0xFFFFFF00U + 200000), Readiness::State::Expired);
+    r.expired();
+    EXPECT_EQ(r.counters().dropped, 1U);
+
+    // Not expired until the first NACK however late the read is
+    r.requested(1000000);
+    EXPECT_EQ(r.poll(1000000 + 1000000), Readiness::State::Read);
+    r.nacked(2000000);
+    EXPECT_EQ(r.poll(2000000 + 199999), Readiness::State::Read);
+    EXPECT_EQ(r.poll(2000000 + 200000), Readiness::State::Expired);
+    r.expired();
+    EXPECT_EQ(r.poll(0), Readiness::State::Read);
+
+    r.resetCounters();
+    EXPECT_EQ(r.counters().reads, 0U);
+}
+
+namespace {
+
+// Advance the simulated time, or yield on the real clock
+void tick(UnitRCWL9620& unit, const uint32_t us = 100)
+{
+    auto fake = dynamic_cast<FakeClock*>(&unit.clock());
+    if (fake) {
+        fake->advance(us);
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+// Update until the number of data is stored
+bool collect_periodic(UnitRCWL9620& unit, const size_t num, const uint32_t ms = 1000)
+{
+    auto timeout_at = unit.clock().millis() + ms;
+    while (unit.available() < num) {
+        if (unit.clock().millis() >= timeout_at) {
+            return false;
+        }
+        unit.update();
+        tick(unit);
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(RCWL9620, SimulatedI2C)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 1000;
+    scfg.nacks      = 1;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000, 5000000});
+
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+
+    // Periodic
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+    ASSERT_TRUE(collect_periodic(unit, 8));
+    const uint32_t expected[] = {100000, 200000, 300000, Data::MAX_DISTANCE_UM};
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(unit.distance_um(), expected[i & 3]) << i;
+        unit.discard();
+    }
+    auto c = unit.readCounters();
+    EXPECT_GE(c.nacks, 8U);  // Additional NACK for each request
+    EXPECT_EQ(c.dropped, 0U);
+
+    // Stop reads the outstanding request
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    EXPECT_FALSE(unit.inPeriodic());
+    EXPECT_EQ(dev.writes, dev.measured);
+
+    // Singleshot
+    Data d{};
+    auto next = dev.measured & 3;
+    EXPECT_TRUE(unit.measureSingleshot(d));
+    EXPECT_EQ(d.distance_um(), expected[next]);
+    EXPECT_EQ(dev.writes, dev.measured);
+
+    // The command is NACKed
+    scfg.write_nack = true;
+    dev.config(scfg);
+    EXPECT_FALSE(unit.requestSingleshot());
+    EXPECT_FALSE(unit.startPeriodicMeasurement(2));
+}
+
+TEST(RCWL9620, SimulatedI2CDeadline)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 20 * 1000;
+    scfg.nacks      = 1000;
+    SimRCWL9620 dev(scfg);
+
+    SimDeviceUnit unit(dev);
+    auto cfg                  = unit.config();
+    cfg.readiness.deadline_ms = 5;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+
+    // Not ready within the deadline
+    Data d{};
+    EXPECT_FALSE(unit.measureSingleshot(d));
+    EXPECT_FALSE(unit.inSingleshot());
+    EXPECT_EQ(unit.readCounters().dropped, 1U);
+    EXPECT_EQ(dev.measured, 0U);
+
+    // Polling mode waits in the call
+    scfg.latency_us = 2000;
+    scfg.nacks      = 0;
+    dev.config(scfg);
+    cfg.readiness.deadline_ms = 50;
+    cfg.readiness.mode        = Readiness::Mode::Polling;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    ASSERT_TRUE(unit.startPeriodicMeasurement(1));
+    dev.fakeClock().advance(1000);
+    auto waits = dev.fakeClock().waits.load();
+    unit.update(true);
+    EXPECT_TRUE(unit.updated());
+    EXPECT_GT(dev.fakeClock().waits, waits);
+    EXPECT_EQ(unit.distance_um(), 1000000U);
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+
+    // The deadline is from the first NACK, so the interval longer than the deadline reads the result
+    SimRCWL9620 dev2{};
+    SimDeviceUnit late(dev2);
+    ASSERT_TRUE(late.begin());
+    ASSERT_GE(late.config().interval_ms, late.config().readiness.deadline_ms);  // Default interval
+    ASSERT_TRUE(late.startPeriodicMeasurement(late.config().readiness.deadline_ms * 2));
+    ASSERT_TRUE(collect_periodic(late, 3, 5000));
+    EXPECT_EQ(late.readCounters().dropped, 0U);
+    EXPECT_EQ(dev2.nacked, 0U);
+    EXPECT_TRUE(late.stopPeriodicMeasurement());
+}
+
+TEST(RCWL9620, SimulatedGPIO)
+{
+    SimRCWL9620 dev;
+    dev.trace({100000, 1234567, 4000000});
+    const uint32_t expected[] = {tof_to_um(SimRCWL9620::echo_us(100000)), tof_to_um(SimRCWL9620::echo_us(1234567)),
+                                 tof_to_um(SimRCWL9620::echo_us(4000000))};
+    const float expected_mm[] = {100.f, 1234.567f, 4000.f};
+
+    // Blocking pulse in
+    {
+        SimDeviceUnit unit(dev, Adapter::Type::GPIO);
+        ASSERT_TRUE(unit.begin());
+        ASSERT_TRUE(unit.startPeriodicMeasurement(1));
+        ASSERT_TRUE(collect_periodic(unit, 6));
+        for (uint32_t i = 0; i < 6; ++i) {
+            EXPECT_EQ(unit.distance_um(), expected[i % 3]) << i;
+            EXPECT_NEAR(unit.distance(), expected_mm[i % 3], 0.2f) << i;  // Resolution of 1us
+            unit.discard();
+        }
+        EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    }
+
+    // Captured echo
+    {
+        dev.trace({100000, 1234567, 4000000});
+        EchoCapture capture;
+        SimDeviceUnit unit(dev, Adapter::Type::GPIO);
+        unit.attachEchoCapture(&capture);
+        ASSERT_TRUE(unit.begin());
+        ASSERT_TRUE(unit.startPeriodicMeasurement(1));
+        ASSERT_TRUE(collect_periodic(unit, 3));
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(unit.distance_um(), expected[i]) << i;
+            unit.discard();
+        }
+    }
+}
+
+TEST(RCWL9620, NextDue)
+{
+    SimRCWL9620 dev;
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+
+    // Periodic
+    ASSERT_TRUE(unit.startPeriodicMeasurement(50));
+    EXPECT_EQ(unit.nextDue(), unit.updatedMillis() + 50);
+    auto reads = dev.reads;
+    unit.update();
+    EXPECT_EQ(dev.reads, reads);  // Not due
+    unit.update(true);
+    EXPECT_GT(dev.reads, reads);  // Forced
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+
+    // Single shot with callback is due after the ranging time
+    uint32_t called{};
+    ASSERT_TRUE(unit.requestSingleshot([&called](UnitRCWL9620&, const Data&, const bool) { ++called; }));
+    EXPECT_NE(unit.nextDue(), NO_DUE);
+    auto timeout_at = unit.clock().millis() + 1000;
+    while (!called && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit);
+    }
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+
+    // Not due until the backoff after NACK is elapsed
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 20 * 1000;
+    SimRCWL9620 dev2(scfg);
+    SimDeviceUnit slow(dev2);
+    ASSERT_TRUE(slow.begin());
+    ASSERT_TRUE(slow.startPeriodicMeasurement(1));
+    slow.update(true);
+    EXPECT_FALSE(slow.updated());
+    EXPECT_EQ(dev2.nacked, 1U);
+    EXPECT_GT(slow.nextDue(), slow.clock().millis());
+    reads = dev2.reads;
+    slow.update();
+    EXPECT_EQ(dev2.reads, reads);
+    EXPECT_TRUE(slow.requestStopPeriodicMeasurement());
+
+    // Checked every millisecond in the echo window (GPIO with the capture)
+    SimRCWL9620::config_t ecfg{};
+    ecfg.no_echo = true;
+    SimRCWL9620 dev3(ecfg);
+    EchoCapture cap;
+    SimDeviceUnit gpio(dev3, Adapter::Type::GPIO);
+    gpio.attachEchoCapture(&cap);
+    ASSERT_TRUE(gpio.begin());
+    ASSERT_TRUE(gpio.startPeriodicMeasurement(1));
+    gpio.update(true);
+    EXPECT_FALSE(gpio.updated());
+    EXPECT_EQ(cap.state(), EchoCapture::State::Armed);
+    EXPECT_GT(gpio.nextDue(), gpio.clock().millis());
+    EXPECT_LE(gpio.nextDue(), gpio.clock().millis() + 1);
+
+    // Scheduled units are never due
+    Scheduler sch;
+    ASSERT_TRUE(sch.add(unit));
+    ASSERT_TRUE(sch.start());
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+    sch.clear();
+}
+
+TEST(RCWL9620, Pacer)
+{
+    FakeClock clock;
+    SimRCWL9620 dev0, dev1;
+    dev0.attachClock(&clock);
+    dev1.attachClock(&clock);
+    SimDeviceUnit unit0(dev0), unit1(dev1);
+    ASSERT_TRUE(unit0.begin());
+    ASSERT_TRUE(unit1.begin());
+    ASSERT_TRUE(unit0.startPeriodicMeasurement(10));
+    ASSERT_TRUE(unit1.startPeriodicMeasurement(30));
+
+    Pacer pacer;
+    pacer.attachClock(&clock);
+    pacer.add(unit0);
+    pacer.add(unit1);
+    EXPECT_EQ(pacer.update(), 0U);  // Not due, refresh the earliest
+    EXPECT_EQ(pacer.nextDue(), unit0.nextDue());
+
+    uint32_t loops{}, updated{}, slept{};
+    auto timeout_at = clock.millis() + 200;
+    while (clock.millis() < timeout_at) {
+        updated += pacer.update();
+        slept += pacer.sleep(5);
+        ++loops;
+        clock.advance(10);  // Cost of the loop
+    }
+    EXPECT_GT(slept, 100U);
+    EXPECT_LT(updated, loops);
+    EXPECT_GE(unit0.available(), 8U);
+    EXPECT_GE(unit1.available(), 3U);
+    EXPECT_LE(unit1.available(), 7U);
+
+    // Nothing is scheduled
+    EXPECT_TRUE(unit0.stopPeriodicMeasurement());
+    EXPECT_TRUE(unit1.stopPeriodicMeasurement());
+    EXPECT_EQ(pacer.update(true), 2U);
+    EXPECT_EQ(pacer.nextDue(), NO_DUE);
+    EXPECT_EQ(pacer.sleep(1), 1U);  // Up to the upper bound
+}
+
+TEST(RCWL9620, Background)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 500;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000});
+    dev.attachClock(&Clock::system());  // The task waits in the real time
+
+    SimDeviceUnit unit(dev, Adapter::Type::I2C, 64);
+    auto cfg      = unit.config();
+    cfg.timestamp = true;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+
+    ASSERT_TRUE(unit.startBackgroundMeasurement(5));
+    EXPECT_TRUE(unit.inBackground());
+    EXPECT_TRUE(unit.inPeriodic());
+    EXPECT_FALSE(unit.startPeriodicMeasurement(5));
+    EXPECT_FALSE(unit.requestSingleshot());
+    EXPECT_EQ(unit.nextDue(), 0U);
+
+    // Slow loop does not delay the reads
+    uint32_t updated{};
+    for (uint32_t i = 0; i < 5; ++i) {
+        m5::utility::delay(40);
+        unit.update();
+        updated += unit.updated();
+    }
+    EXPECT_EQ(updated, 5U);
+    EXPECT_GE(unit.available(), 20U);
+    EXPECT_EQ(unit.backgroundDropped(), 0U);
+
+    const uint32_t expected[] = {100000, 200000, 300000};
+    uint32_t prev_request{}, idx{}, worst_gap{};
+    while (!unit.empty()) {
+        auto td = unit.oldestTimed();
+        EXPECT_EQ(td.data.distance_um(), expected[idx++ % 3]);
+        EXPECT_GE(td.timestamp.latency_us(), 500U);
+        if (prev_request) {
+            worst_gap = std::max(worst_gap, td.timestamp.request_us - prev_request);
+        }
+        prev_request = td.timestamp.request_us;
+        unit.discard();
+    }
+    EXPECT_LT(worst_gap, 40 * 1000U);  // Shorter than the delay of the loop
+
+    EXPECT_TRUE(unit.stopBackgroundMeasurement());
+    EXPECT_FALSE(unit.inBackground());
+    EXPECT_FALSE(unit.inPeriodic());
+    EXPECT_EQ(dev.writes, dev.measured);
+    EXPECT_FALSE(unit.stopBackgroundMeasurement());
+
+    // Queue is smaller than the samples in a loop
+    SimRCWL9620 dev2(scfg);
+    dev2.attachClock(&Clock::system());
+    SimDeviceUnit small(dev2, Adapter::Type::I2C, 4);
+    ASSERT_TRUE(small.begin());
+    ASSERT_TRUE(small.startBackgroundMeasurement(2));
+    m5::utility::delay(50);
+    small.update();
+    EXPECT_EQ(small.available(), 4U);
+    EXPECT_GT(small.backgroundDropped(), 0U);
+    EXPECT_TRUE(small.stopPeriodicMeasurement());
+    EXPECT_FALSE(small.inBackground());
+
+    // Recovering if the request fails, and the task is restarted on the recovery
+    ASSERT_TRUE(small.startBackgroundMeasurement(2));
+    dev2.nackCommand(true);
+    m5::utility::delay(20);
+    small.update();
+    EXPECT_FALSE(small.inBackground());
+    EXPECT_TRUE(small.inPeriodic());
+    EXPECT_TRUE(small.recovering());
+    dev2.nackCommand(false);
+    m5::utility::delay(small.config().recovery.initial_ms + 10);
+    small.update();
+    EXPECT_FALSE(small.recovering());
+    EXPECT_TRUE(small.inBackground());
+    EXPECT_EQ(small.recoveryCounters().recoveries, 1U);
+    EXPECT_TRUE(small.stopBackgroundMeasurement());
+
+    // Suspended if the recovery is disabled
+    auto scfg2             = small.config();
+    scfg2.recovery.enabled = false;
+    small.config(scfg2);
+    ASSERT_TRUE(small.begin());
+    ASSERT_TRUE(small.startBackgroundMeasurement(2));
+    dev2.nackCommand(true);
+    m5::utility::delay(20);
+    small.update();
+    EXPECT_FALSE(small.inBackground());
+    EXPECT_FALSE(small.inPeriodic());
+    dev2.nackCommand(false);
+}
+
+TEST(RCWL9620, LockFreeRingBuffer)
+{
+    RingBuffer<uint32_t> rb(4, false);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(rb.push_back(i));
+    }
+    EXPECT_TRUE(rb.full());
+    EXPECT_FALSE(rb.push_back(4));  // Not overwritten
+    EXPECT_EQ(rb.front().value(), 0U);
+    EXPECT_EQ(rb.back().value(), 3U);
+
+    // Stress, producer and consumer in different threads
+    constexpr uint32_t num{200000};
+    RingBuffer<uint32_t> q(16, false);
+    std::thread producer([&q]() {
+        for (uint32_t i = 1; i <= num;) {
+            if (q.push_back(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected{1}, errors{};
+    uint32_t out[8]{};
+    while (expected <= num) {
+        if (expected & 1) {
+            auto v = q.front();
+            if (v.has_value()) {
+                errors += (v.value() != expected++);
+                q.pop_front();
+                continue;
+            }
+        } else {
+            auto n = q.drain(out, 8);
+            for (uint32_t i = 0; i < n; ++i) {
+                errors += (out[i] != expected++);
+            }
+            if (n) {
+                continue;
+            }
+        }
+        std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_EQ(errors, 0U);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(RCWL9620, LockFreeUnit)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    std::vector<uint32_t> trace(100000);
+    for (uint32_t i = 0; i < trace.size(); ++i) {
+        trace[i] = 20000 + i * 40;
+    }
+    dev.trace(trace);
+
+    SimDeviceUnit unit(dev, Adapter::Type::I2C, 8);
+    auto cfg      = unit.config();
+    cfg.lock_free = true;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    ASSERT_TRUE(unit.startPeriodicMeasurement(1));
+
+    // update() in the other thread, consume in this thread
+    std::atomic<bool> done{};
+    // Bounded by the samples, so the trace never wraps
+    std::thread producer([&unit, &dev, &done, &trace]() {
+        while (dev.measured < trace.size() / 4) {
+            unit.update(true);
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+    uint32_t consumed{}, prev{}, errors{};
+    while (!done || unit.available()) {
+        if (unit.available()) {
+            auto um = unit.oldest().raw_distance();
+            errors += (um <= prev);
+            prev = um;
+            unit.discard();
+            ++consumed;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_EQ(errors, 0U);
+    EXPECT_GT(consumed, 100U);
+    EXPECT_EQ(consumed + unit.droppedSamples(), dev.measured);
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+
+    // The parallel rings are not shareable
+    cfg.timestamp = true;
+    unit.config(cfg);
+    EXPECT_FALSE(unit.begin());
+    cfg.timestamp        = false;
+    cfg.filter.ema_alpha = 64;
+    unit.config(cfg);
+    EXPECT_FALSE(unit.begin());
+    cfg.filter = Filter::config_t{};
+    unit.config(cfg);
+    EXPECT_TRUE(unit.begin());
+}
+
+namespace {
+template <size_t N>
+class SimStaticUnit : public UnitRCWL9620Static<N, sizeof(SimInterfaceI2C)> {
+public:
+    explicit SimStaticUnit(SimRCWL9620& dev) : _dev{dev}
+    {
+        auto cfg           = this->config();
+        cfg.start_periodic = false;
+        this->config(cfg);
+        this->attachClock(&dev.clock());
+    }
+
+protected:
+    virtual UnitRCWL9620::Interface* create_interface(const Adapter::Type) override
+    {
+        return this->template make_interface<SimInterfaceI2C>(*this, _dev);
+    }
+    virtual uint32_t minimum_interval() const override
+    {
+        return 1;
+    }
+
+private:
+    SimRCWL9620& _dev;
+};
+
+// Allocations on the construction and on begin()
+template <class U>
+std::pair<uint32_t, uint32_t> allocations_of(SimRCWL9620& dev)
+{
+    uint32_t before = allocations;
+    U unit(dev);
+    const uint32_t construction = allocations - before;
+    before                      = allocations;
+    EXPECT_TRUE(unit.begin());
+    return std::make_pair(construction, allocations - before);
+}
+
+}  // namespace
+
+TEST(RCWL9620, StaticStorage)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000, 400000});
+
+    struct DynamicUnit : SimDeviceUnit {
+        explicit DynamicUnit(SimRCWL9620& d) : SimDeviceUnit(d, Adapter::Type::I2C, 8)
+        {
+        }
+    };
+    // The adapter of the component is allocated in both, the data of the dynamic one on begin()
+    auto dynamic_allocs = allocations_of<DynamicUnit>(dev);
+    auto static_allocs  = allocations_of<SimStaticUnit<8>>(dev);
+    EXPECT_EQ(static_allocs.first, dynamic_allocs.first);
+    EXPECT_GT(dynamic_allocs.second, static_allocs.second);
+    EXPECT_EQ(static_allocs.second, 1U);  // Only the recovery enabled by default
+
+    // UltraSonic units hold the interface in the object
+    static_assert(sizeof(UnitUltraSonicI2C) >= sizeof(UnitRCWL9620) + sizeof(InterfaceI2C), "Not inline");
+    static_assert(sizeof(UnitUltraSonicIO) >= sizeof(UnitRCWL9620) + sizeof(InterfaceGPIO), "Not inline");
+
+    // The owned data is allocated by begin()
+    {
+        UnitRCWL9620 bare;
+        rcwl9620::Data buf[2]{};
+        EXPECT_EQ(bare.available(), 0U);
+        EXPECT_TRUE(bare.empty());
+        EXPECT_FALSE(bare.full());
+        EXPECT_EQ(bare.readAll(buf, 2), 0U);
+        EXPECT_EQ(bare.drain(buf, 2), 0U);
+        EXPECT_EQ(bare.view().size(), 0U);
+        EXPECT_EQ(bare.oldestTimestamp().read_us, 0U);
+        bare.discard();
+        bare.flush();
+    }
+
+    SimStaticUnit<8> unit(dev);
+    EXPECT_EQ(unit.component_config().stored_size, 8U);
+    ASSERT_TRUE(unit.begin());
+    ASSERT_TRUE(unit.startPeriodicMeasurement(1));
+    uint32_t cnt{};
+    auto timeout_at = unit.clock().millis() + 100;
+    while (cnt < 12 && unit.clock().millis() < timeout_at) {
+        unit.update(true);
+        cnt += unit.updated();
+        tick(unit);
+    }
+    EXPECT_EQ(cnt, 12U);
+    EXPECT_EQ(unit.available(), 8U);
+    EXPECT_TRUE(unit.full());
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+
+    // Stored size is fixed
+    auto ccfg        = unit.component_config();
+    ccfg.stored_size = 16;
+    unit.component_config(ccfg);
+    EXPECT_FALSE(unit.begin());
+}
+
+TEST(RCWL9620, Burst)
+{
+    SimRCWL9620::config_t scfg{};
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000, 400000, 500000});
+
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+
+    BurstSample samples[5]{};
+    EXPECT_FALSE(unit.measureBurst(nullptr, 5));
+    EXPECT_FALSE(unit.measureBurst(samples, 0));
+
+    // Minimum spacing
+    EXPECT_TRUE(unit.measureBurst(samples, 5));
+    EXPECT_FALSE(unit.inBurst());
+    EXPECT_EQ(unit.burstCompleted(), 5U);
+    EXPECT_EQ(dev.writes, 5U);
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(samples[i].valid) << i;
+        EXPECT_EQ(samples[i].data.distance_um(), (i + 1) * 100000U) << i;
+        EXPECT_GE(samples[i].timestamp.latency_us(), scfg.latency_us) << i;
+        if (i) {
+            EXPECT_GE(samples[i].timestamp.request_us, samples[i - 1].timestamp.read_us) << i;
+        }
+    }
+
+    // Spaced
+    EXPECT_TRUE(unit.measureBurst(samples, 3, 10));
+    for (uint32_t i = 1; i < 3; ++i) {
+        EXPECT_TRUE(samples[i].valid) << i;
+        EXPECT_GE(samples[i].timestamp.request_us - samples[i - 1].timestamp.request_us, 9000U) << i;
+    }
+
+    // Non-blocking with the callback
+    uint32_t called{}, valid{};
+    EXPECT_TRUE(unit.requestBurst(samples, 4, 0, [&called, &valid](UnitRCWL9620&, BurstSample* s, const size_t k) {
+        ++called;
+        for (size_t i = 0; i < k; ++i) {
+            valid += s[i].valid;
+        }
+    }));
+    EXPECT_TRUE(unit.inBurst());
+    EXPECT_FALSE(unit.requestBurst(samples, 4));
+    EXPECT_FALSE(unit.requestSingleshot());
+    EXPECT_FALSE(unit.startPeriodicMeasurement(2));
+    EXPECT_NE(unit.nextDue(), NO_DUE);
+    auto timeout_at = unit.clock().millis() + 1000;
+    while (!called && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit);
+    }
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(valid, 4U);
+    EXPECT_FALSE(unit.inBurst());
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+
+    // Failed to request
+    dev.nackCommand(true);
+    EXPECT_TRUE(unit.measureBurst(samples, 2));
+    EXPECT_FALSE(samples[0].valid);
+    EXPECT_FALSE(samples[1].valid);
+    dev.nackCommand(false);
+
+    // Not while periodic
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+    EXPECT_FALSE(unit.requestBurst(samples, 2));
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+}
+
+TEST(RCWL9620, Motion)
+{
+    Motion::config_t cfg{};
+    Motion m(cfg);
+    EXPECT_FALSE(m.enabled());
+
+    cfg.alpha = 128;
+    cfg.beta  = 32;
+    m.config(cfg);
+    EXPECT_TRUE(m.enabled());
+    EXPECT_TRUE(std::isnan(m.distance()));
+    EXPECT_TRUE(std::isnan(m.velocity_mm_s()));
+    EXPECT_TRUE(std::isnan(m.timeToContact_ms()));
+
+    // Approaching at 500 mm/s from 2000 mm with the jittered interval and noise
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> jitter(15000, 25000);
+    std::normal_distribution<float> noise(0.0f, 3.0f);  // mm
+    uint32_t at{1000};
+    for (uint32_t i = 0; i < 100; ++i) {
+        at += jitter(rng);
+        const float mm = 2000.f - 500.f * at * 1e-6f;
+        m.update((uint32_t)((mm + noise(rng)) * 1000.f), at);
+    }
+    const float mm = 2000.f - 500.f * at * 1e-6f;
+    EXPECT_EQ(m.count(), 100U);
+    EXPECT_NEAR(m.distance(), mm, 10.f);
+    EXPECT_NEAR(m.velocity_mm_s(), -500.f, 50.f);
+    EXPECT_NEAR(m.timeToContact_ms(), mm / 500.f * 1000.f, mm / 500.f * 100.f);  // 10%
+    EXPECT_NEAR(m.timeToContact_ms(100.f), (mm - 100.f) / 500.f * 1000.f, (mm - 100.f) / 500.f * 100.f);
+    EXPECT_FLOAT_EQ(m.timeToContact_ms(mm + 100.f), 0.0f);
+
+    // Stationary
+    m.reset();
+    for (uint32_t i = 0; i < 100; ++i) {
+        at += jitter(rng);
+        m.update((uint32_t)((1000.f + noise(rng)) * 1000.f), at);
+    }
+    EXPECT_NEAR(m.distance(), 1000.f, 5.f);
+    EXPECT_NEAR(m.velocity_mm_s(), 0.0f, 50.f);
+
+    // Receding
+    for (uint32_t i = 0; i < 100; ++i) {
+        at += 20000;
+        m.update(1000000 + i * 4000, at);  // 200 mm/s
+    }
+    EXPECT_NEAR(m.velocity_mm_s(), 200.f, 1.f);
+    EXPECT_TRUE(std::isnan(m.timeToContact_ms()));
+
+    // Restart after the gap
+    at += cfg.reset_gap_ms * 1000U + 1;
+    m.update(500000, at);
+    EXPECT_EQ(m.count(), 1U);
+    EXPECT_FLOAT_EQ(m.distance(), 500.f);
+    EXPECT_TRUE(std::isnan(m.velocity_mm_s()));
+    m.update(490000, at + 10000);
+    EXPECT_NEAR(m.velocity_mm_s(), -1000.f, 0.1f);
+}
+
+TEST(RCWL9620, MotionOnUpdate)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    std::vector<uint32_t> trace(64);
+    for (uint32_t i = 0; i < trace.size(); ++i) {
+        trace[i] = 1000000 - i * 5000;
+    }
+    trace.back() = 0xFFFFFF;  // Lost
+    dev.trace(trace);
+
+    SimDeviceUnit unit(dev);
+    auto cfg         = unit.config();
+    cfg.motion.alpha = 128;
+    cfg.motion.beta  = 64;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_TRUE(unit.motion().enabled());
+    EXPECT_TRUE(std::isnan(unit.velocity_mm_s()));
+
+    // 5 mm each 10 ms
+    ASSERT_TRUE(unit.startPeriodicMeasurement(10));
+    while (unit.motion().count() < trace.size() - 2) {
+        unit.update();
+        tick(unit, 1000);
+    }
+    EXPECT_LT(unit.velocity_mm_s(), -250.f);
+    EXPECT_GT(unit.velocity_mm_s(), -750.f);
+    EXPECT_FALSE(std::isnan(unit.timeToContact_ms()));
+
+    // Reset if the target is lost
+    while (unit.motion().count()) {
+        unit.update();
+        tick(unit, 1000);
+    }
+    EXPECT_TRUE(std::isnan(unit.velocity_mm_s()));
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+}
+
+TEST(RCWL9620, Zones)
+{
+    Zones zones;
+    struct event_t {
+        uint8_t index;
+        bool entered;
+        uint32_t um;
+    };
+    std::vector<event_t> events;
+    auto cb = [&events](const uint8_t index, const bool entered, const uint32_t um) {
+        events.push_back(event_t{index, entered, um});
+    };
+
+    EXPECT_EQ(zones.add({300000, 200000, 0}), -1);  // Invalid
+    EXPECT_EQ(zones.add({0, 300000, 20000}, cb), 0);
+    EXPECT_EQ(zones.add({500000, 1000000, 0}, cb), 1);
+    EXPECT_EQ(zones.add({0, 1000000, 0}), 2);  // Without callback
+    EXPECT_EQ(zones.size(), 3U);
+
+    // First sample inside is regarded as entered
+    zones.update(800000);
+    EXPECT_EQ(zones.insideMask(), 0x06);
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_EQ(events[0].index, 1U);
+    EXPECT_TRUE(events[0].entered);
+    EXPECT_EQ(events[0].um, 800000U);
+    EXPECT_EQ(zones.takeEntered(), 0x06);
+    EXPECT_EQ(zones.takeEntered(), 0x00);
+    events.clear();
+
+    // Approaching
+    zones.update(290000);
+    EXPECT_TRUE(zones.inside(0));
+    EXPECT_FALSE(zones.inside(1));
+    EXPECT_TRUE(zones.inside(2));
+    ASSERT_EQ(events.size(), 2U);
+    EXPECT_EQ(events[0].index, 0U);
+    EXPECT_TRUE(events[0].entered);
+    EXPECT_EQ(events[1].index, 1U);
+    EXPECT_FALSE(events[1].entered);
+    EXPECT_EQ(zones.entered(), 0x01);
+    EXPECT_EQ(zones.left(), 0x02);
+    events.clear();
+
+    // Chattering around the edge is suppressed by the hysteresis
+    for (auto&& um : {310000U, 295000U, 319000U, 301000U}) {
+        zones.update(um);
+        EXPECT_TRUE(zones.inside(0)) << um;
+    }
+    EXPECT_TRUE(events.empty());
+    zones.update(321000);
+    EXPECT_FALSE(zones.inside(0));
+    ASSERT_EQ(events.size(), 1U);
+    EXPECT_FALSE(events[0].entered);
+    EXPECT_EQ(zones.takeLeft(), 0x03);
+    EXPECT_EQ(zones.left(), 0x00);
+    events.clear();
+
+    // Reset forgets the state
+    zones.reset();
+    EXPECT_EQ(zones.insideMask(), 0x00);
+    zones.update(100000);
+    EXPECT_EQ(zones.insideMask(), 0x05);
+    EXPECT_EQ(events.size(), 1U);
+
+    // Full
+    zones.clear();
+    EXPECT_EQ(zones.size(), 0U);
+    for (uint8_t i = 0; i < Zones::MAX_ZONES; ++i) {
+        EXPECT_EQ(zones.add({i * 100000U, (i + 1) * 100000U, 0}), i);
+    }
+    EXPECT_LT(zones.add({0, 100000, 0}), 0);
+}
+
+TEST(RCWL9620, ZonesOnUpdate)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    dev.trace({1000000, 800000, 400000, 200000, 400000, 800000});
+
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+
+    uint32_t entered{}, left{};
+    EXPECT_EQ(unit.addZone({0, 500000, 10000},
+                           [&entered, &left](const uint8_t, const bool in, const uint32_t) { in ? ++entered : ++left; }),
+              0);
+    EXPECT_EQ(unit.addZone({0, 300000, 10000}), 1);
+    EXPECT_EQ(unit.zones().size(), 2U);
+
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+    ASSERT_TRUE(collect_periodic(unit, 6));
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    EXPECT_EQ(entered, 1U);
+    EXPECT_EQ(left, 1U);
+    EXPECT_FALSE(unit.inZone(0));
+    EXPECT_EQ(unit.takeZoneEntered(), 0x03);
+    EXPECT_EQ(unit.takeZoneLeft(), 0x03);
+    EXPECT_EQ(unit.takeZoneEntered(), 0x00);
+
+    unit.clearZones();
+    EXPECT_EQ(unit.zones().size(), 0U);
+}
+
+TEST(RCWL9620, NonBlockingStop)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 20 * 1000;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000});
+
+    SimDeviceUnit unit(dev);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_TRUE(unit.idle());
+    EXPECT_FALSE(unit.requestStopPeriodicMeasurement());
+
+    ASSERT_TRUE(unit.startPeriodicMeasurement(50));
+    ASSERT_TRUE(collect_periodic(unit, 1));
+    EXPECT_FALSE(unit.idle());
+
+    uint32_t called{};
+    EXPECT_TRUE(unit.requestStopPeriodicMeasurement([&called](UnitRCWL9620&) { ++called; }));
+    EXPECT_FALSE(unit.inPeriodic());
+    EXPECT_TRUE(unit.draining());
+    EXPECT_FALSE(unit.idle());
+    EXPECT_NE(unit.nextDue(), NO_DUE);
+
+    // Other measurements are not started while draining
+    EXPECT_FALSE(unit.requestStopPeriodicMeasurement());
+    EXPECT_FALSE(unit.requestSingleshot());
+    EXPECT_FALSE(unit.startPeriodicMeasurement(50));
+    BurstSample samples[2]{};
+    EXPECT_FALSE(unit.requestBurst(samples, 2));
+
+    const auto waits = dev.fakeClock().waits.load();
+    auto timeout_at  = unit.clock().millis() + 1000;
+    while (!called && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit);
+    }
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(dev.fakeClock().waits, waits);  // Never waits in update()
+    EXPECT_FALSE(unit.draining());
+    EXPECT_TRUE(unit.idle());
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+    EXPECT_EQ(dev.writes, dev.measured);  // Outstanding request has been read
+
+    Data d{};
+    EXPECT_TRUE(unit.measureSingleshot(d));
+
+    // Blocking stop finishes the draining
+    ASSERT_TRUE(unit.startPeriodicMeasurement(50));
+    EXPECT_TRUE(unit.requestStopPeriodicMeasurement());
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    EXPECT_TRUE(unit.idle());
+    EXPECT_EQ(dev.writes, dev.measured);
+
+    // GPIO without the capture has no outstanding request, the stop does not trigger the new one
+    SimRCWL9620 dev2{};
+    SimDeviceUnit gpio(dev2, Adapter::Type::GPIO);
+    ASSERT_TRUE(gpio.begin());
+    ASSERT_TRUE(gpio.startPeriodicMeasurement(1));
+    ASSERT_TRUE(collect_periodic(gpio, 1));
+    auto measured = dev2.measured;
+    auto reads    = dev2.reads;
+    called        = 0;
+    EXPECT_TRUE(gpio.requestStopPeriodicMeasurement([&called](UnitRCWL9620&) { ++called; }));
+    EXPECT_EQ(called, 1U);
+    EXPECT_FALSE(gpio.draining());
+    EXPECT_TRUE(gpio.idle());
+    EXPECT_EQ(gpio.nextDue(), NO_DUE);
+    EXPECT_EQ(dev2.measured, measured);
+    EXPECT_EQ(dev2.reads, reads);
+
+    ASSERT_TRUE(gpio.startPeriodicMeasurement(1));
+    ASSERT_TRUE(collect_periodic(gpio, 1));
+    measured = dev2.measured;
+    reads    = dev2.reads;
+    EXPECT_TRUE(gpio.stopPeriodicMeasurement());
+    EXPECT_TRUE(gpio.idle());
+    EXPECT_EQ(dev2.measured, measured);
+    EXPECT_EQ(dev2.reads, reads);
+}
+
+TEST(RCWL9620, MaxRange)
+{
+    // Derived timings
+    static_assert(um_to_tof(1000000) == 5830U, "Invalid conversion");
+    static_assert(um_to_tof(1000000, 0) == 0xFFFFFFFFU, "Invalid speed");
+    static_assert(echo_timeout_us(Data::MAX_DISTANCE_UM) == ECHO_TIMEOUT_US, "Full range");
+    static_assert(echo_timeout_us(1000000) == 5830U + 5830U / 4U, "1m");
+    static_assert(minimum_interval_ms(ECHO_TIMEOUT_US) == 50U, "Full range");
+    static_assert(minimum_interval_ms(echo_timeout_us(1000000)) == 8U, "1m");
+    for (uint32_t mm = 100; mm < 4500; mm += 100) {
+        // Longer than the echo of the range, shorter than the full range
+        EXPECT_GT(echo_timeout_us(mm * 1000), um_to_tof(mm * 1000)) << mm;
+        EXPECT_LT(echo_timeout_us(mm * 1000), ECHO_TIMEOUT_US) << mm;
+        EXPECT_LE(tof_to_um(echo_timeout_us(mm * 1000)), mm * 1000 * 5 / 4 + 1000) << mm;
+    }
+    // Speed of sound affects the timeout
+    EXPECT_GT(echo_timeout_us(1000000, speed_of_sound(-20.f)), echo_timeout_us(1000000, speed_of_sound(40.f)));
+
+    // Unit
+    {
+        UnitUltraSonicIO io;
+        EXPECT_EQ(io.maxRange_um(), Data::MAX_DISTANCE_UM);
+        EXPECT_EQ(io.echoTimeout_us(), ECHO_TIMEOUT_US);
+    }
+
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    dev.trace({500000, 2000000, 900000});
+
+    for (auto&& type : {Adapter::Type::I2C, Adapter::Type::GPIO}) {
+        SCOPED_TRACE(type == Adapter::Type::I2C ? "I2C" : "GPIO");
+        SimDeviceUnit unit(dev, type);
+        auto cfg         = unit.config();
+        cfg.max_range_mm = 1000;
+        unit.config(cfg);
+        ASSERT_TRUE(unit.begin());
+        EXPECT_EQ(unit.maxRange_um(), 1000000U);
+        EXPECT_EQ(unit.echoTimeout_us(), echo_timeout_us(1000000));
+
+        dev.trace({500000, 2000000, 900000});
+        Data d{};
+        EXPECT_TRUE(unit.measureSingleshot(d));
+        EXPECT_NEAR(d.distance_um(), 500000U, 200U);  // Quantized by the echo width (us) if GPIO
+        if (type == Adapter::Type::I2C) {
+            // Clamped
+            EXPECT_TRUE(unit.measureSingleshot(d));
+            EXPECT_EQ(d.raw_distance(), 1000000U);
+        } else {
+            // No echo within the window, and the retry measures the next
+            const auto nacked = dev.nacked;
+            EXPECT_TRUE(unit.measureSingleshot(d));
+            EXPECT_EQ(dev.nacked, nacked + 1);
+            EXPECT_NEAR(d.distance_um(), 900000U, 200U);
+            continue;
+        }
+        EXPECT_TRUE(unit.measureSingleshot(d));
+        EXPECT_EQ(d.distance_um(), 900000U);
+    }
+
+    // Clamped to the measurable range
+    SimDeviceUnit unit(dev);
+    auto cfg         = unit.config();
+    cfg.max_range_mm = 10000;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_EQ(unit.maxRange_um(), Data::MAX_DISTANCE_UM);
+    cfg.max_range_mm = 1;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    EXPECT_EQ(unit.maxRange_um(), Data::MIN_DISTANCE_UM);
+}
+
+TEST(RCWL9620, Recovery)
+{
+    Recovery::config_t cfg{};
+    cfg.initial_ms   = 10;
+    cfg.max_ms       = 50;
+    cfg.max_attempts = 4;
+    Recovery r{};
+    r.config(cfg);
+
+    r.begin(1000);
+    EXPECT_FALSE(r.recovering());
+    EXPECT_FLOAT_EQ(r.availability(1100), 1.0f);
+
+    r.fault(1100);
+    EXPECT_TRUE(r.recovering());
+    EXPECT_FALSE(r.due(1109));
+    EXPECT_TRUE(r.due(1110));
+    r.fault(1105);  // Already recovering
+    EXPECT_EQ(r.counters().faults, 1U);
+
+    // Bounded exponential backoff
+    EXPECT_TRUE(r.failed(1110));
+    EXPECT_EQ(r.backoff(), 20U);
+    EXPECT_EQ(r.next(), 1130U);
+    EXPECT_TRUE(r.failed(1130));
+    EXPECT_EQ(r.backoff(), 40U);
+    EXPECT_TRUE(r.failed(1170));
+    EXPECT_EQ(r.backoff(), 50U);
+
+    r.recovered(1220);
+    EXPECT_FALSE(r.recovering());
+    EXPECT_EQ(r.downtime(1300), 120U);
+    EXPECT_EQ(r.uptime(1300), 180U);
+    EXPECT_FLOAT_EQ(r.availability(1300), 0.6f);
+    auto c = r.counters();
+    EXPECT_EQ(c.faults, 1U);
+    EXPECT_EQ(c.recoveries, 1U);
+    EXPECT_EQ(c.attempts, 4U);
+    EXPECT_EQ(c.gave_up, 0U);
+
+    // Give up
+    r.fault(1300);
+    EXPECT_EQ(r.backoff(), 10U);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(r.failed(r.next()));
+    }
+    EXPECT_FALSE(r.failed(r.next()));
+    EXPECT_FALSE(r.recovering());
+    EXPECT_EQ(r.counters().gave_up, 1U);
+
+    // Wrap around
+    r.begin(0xFFFFFFF0U);
+    r.fault(0xFFFFFFF8U);
+    EXPECT_FALSE(r.due(0xFFFFFFFFU));
+    EXPECT_TRUE(r.due(2U));
+    r.recovered(2U);
+    EXPECT_EQ(r.downtime(2U), 10U);
+    EXPECT_EQ(r.uptime(0x10U), 22U);
+}
+
+TEST(RCWL9620, RecoveryOnUpdate)
+{
+    // I2C only, the trigger of GPIO does not fail
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    SimDeviceUnit unit(dev, Adapter::Type::I2C, 8);
+    auto cfg                  = unit.config();
+    cfg.recovery.initial_ms   = 10;
+    cfg.recovery.max_ms       = 40;
+    cfg.recovery.max_attempts = 0;
+    cfg.recovery.bus_recovery = true;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+
+    // Fault injection
+    dev.nackCommand(true);
+    auto timeout_at = unit.clock().millis() + 1000;
+    while (!unit.recovering() && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit, 1000);
+    }
+    ASSERT_TRUE(unit.recovering());
+    EXPECT_TRUE(unit.inPeriodic());
+    EXPECT_EQ(unit.recoveryCounters().faults, 1U);
+    // Not attempted until due
+    EXPECT_GE(unit.nextDue(), unit.clock().millis());
+    tick(unit, 100 * 1000);
+    unit.update();
+    unit.update();
+    EXPECT_TRUE(unit.recovering());
+    EXPECT_GE(unit.recovery().backoff(), 20U);
+    EXPECT_LE(unit.recovery().backoff(), 40U);
+    EXPECT_GT(unit.recoveryCounters().attempts, 0U);
+
+    // Resumed
+    dev.nackCommand(false);
+    timeout_at = unit.clock().millis() + 1000;
+    while (unit.recovering() && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit, 1000);
+    }
+    EXPECT_FALSE(unit.recovering());
+    EXPECT_TRUE(unit.inPeriodic());
+    EXPECT_EQ(unit.recoveryCounters().recoveries, 1U);
+    EXPECT_LT(unit.availability(), 1.0f);
+    EXPECT_GT(unit.availability(), 0.0f);
+    EXPECT_LE(unit.uptime_ms(), 1000U);
+    unit.flush();
+    EXPECT_TRUE(collect_periodic(unit, 2));
+
+    // Stop while recovering
+    dev.nackCommand(true);
+    timeout_at = unit.clock().millis() + 1000;
+    while (!unit.recovering() && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit, 1000);
+    }
+    ASSERT_TRUE(unit.recovering());
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    EXPECT_FALSE(unit.inPeriodic());
+    EXPECT_FALSE(unit.recovering());
+    EXPECT_EQ(unit.nextDue(), NO_DUE);
+
+    // Suspended after the attempts
+    cfg.recovery.max_attempts = 2;
+    unit.config(cfg);
+    ASSERT_TRUE(unit.begin());
+    dev.nackCommand(false);
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+    dev.nackCommand(true);
+    timeout_at = unit.clock().millis() + 1000;
+    while (unit.inPeriodic() && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit, 1000);
+    }
+    EXPECT_FALSE(unit.inPeriodic());
+    EXPECT_EQ(unit.recoveryCounters().gave_up, 1U);
+    EXPECT_EQ(unit.recoveryCounters().attempts, 2U);
+    dev.nackCommand(false);
+}
+
+TEST(RCWL9620, Histogram)
+{
+    EXPECT_EQ(Histogram::index(0), 0U);
+    EXPECT_EQ(Histogram::index(1), 1U);
+    EXPECT_EQ(Histogram::index(2), 2U);
+    EXPECT_EQ(Histogram::index(3), 2U);
+    EXPECT_EQ(Histogram::index(4), 3U);
+    EXPECT_EQ(Histogram::index(1U << 14), 15U);
+    EXPECT_EQ(Histogram::index(UINT32_MAX), Histogram::BUCKETS - 1);
+    EXPECT_EQ(Histogram::lower(0), 0U);
+    EXPECT_EQ(Histogram::lower(3), 4U);
+
+    StatsRecorder rec{};
+    auto s = rec.snapshot();
+    EXPECT_EQ(s.read_us.count, 0U);
+    EXPECT_EQ(s.read_us.min, 0U);
+    EXPECT_EQ(s.read_us.percentile(0.5f), 0U);
+
+    // 90 x 100us, 10 x 1000us
+    for (uint32_t i = 0; i < 90; ++i) {
+        rec.read(100, true, false);
+    }
+    for (uint32_t i = 0; i < 10; ++i) {
+        rec.read(1000, true, false);
+    }
+    rec.read(5, false, false);
+    rec.read(5000, true, true);
+    s = rec.snapshot();
+    EXPECT_EQ(s.read_us.count, 102U);
+    EXPECT_EQ(s.read_us.min, 5U);
+    EXPECT_EQ(s.read_us.max, 5000U);
+    EXPECT_EQ(s.read_us.sum, 90U * 100 + 10U * 1000 + 5 + 5000);
+    EXPECT_EQ(s.read_us.buckets[Histogram::index(100)], 90U);
+    EXPECT_EQ(s.read_us.percentile(0.5f), 127U);
+    EXPECT_EQ(s.read_us.percentile(0.95f), 1023U);
+    EXPECT_EQ(s.read_us.percentile(1.0f), 5000U);
+    EXPECT_EQ(s.samples, 100U);
+    EXPECT_EQ(s.not_ready, 1U);
+    EXPECT_EQ(s.timeouts, 1U);
+
+    // Sum over 32 bits
+    for (uint32_t i = 0; i < 3; ++i) {
+        rec.lateness(UINT32_MAX / 2, 1000);
+    }
+    s = rec.snapshot();
+    EXPECT_EQ(s.lateness_us.sum, 3ULL * (UINT32_MAX / 2));
+    EXPECT_EQ(s.overruns, 3U);
+
+    rec.bus(400);
+    EXPECT_FLOAT_EQ(rec.snapshot().bytesPerSample(), 4.0f);
+    rec.reset();
+    s = rec.snapshot();
+    EXPECT_EQ(s.read_us.count, 0U);
+    EXPECT_EQ(s.samples, 0U);
+    EXPECT_EQ(s.bus_bytes, 0U);
+}
+
+TEST(RCWL9620, StatsOnUpdate)
+{
+    SimRCWL9620::config_t scfg{};
+    scfg.latency_us = 0;
+    SimRCWL9620 dev(scfg);
+    dev.trace({100000, 200000, 300000});
+    SimDeviceUnit unit(dev, Adapter::Type::I2C, 4);
+    ASSERT_TRUE(unit.begin());
+
+    if (!UnitRCWL9620::statsEnabled()) {
+        ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+        EXPECT_TRUE(collect_periodic(unit, 2));
+        EXPECT_TRUE(unit.stopPeriodicMeasurement());
+        EXPECT_EQ(unit.stats().samples, 0U);
+        return;
+    }
+
+    unit.resetStats();
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+    auto timeout_at = unit.clock().millis() + 1000;
+    while (unit.stats().samples < 8 && unit.clock().millis() < timeout_at) {
+        unit.update();
+        tick(unit);
+    }
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    auto s = unit.stats();
+    EXPECT_GE(s.samples, 8U);
+    EXPECT_GE(s.request_us.count, s.samples);
+    EXPECT_GE(s.read_us.count, s.samples);
+    EXPECT_GE(s.lateness_us.count, 8U);
+    EXPECT_GT(s.overwritten, 0U);  // Stored size is 4
+    EXPECT_EQ(s.dropped, 0U);
+    EXPECT_EQ(s.request_failures, 0U);
+    // Address + command, and address + 3 bytes
+    EXPECT_GE(s.bytesPerSample(), 6.0f);
+
+    // Overrun if updated later than the interval
+    unit.resetStats();
+    ASSERT_TRUE(unit.startPeriodicMeasurement(2));
+    tick(unit, 10 * 1000);
+    unit.update();
+    EXPECT_TRUE(unit.updated());
+    EXPECT_TRUE(unit.stopPeriodicMeasurement());
+    s = unit.stats();
+    EXPECT_EQ(s.lateness_us.count, 1U);
+    EXPECT_GE(s.lateness_us.max, 2000U);
+    EXPECT_EQ(s.overruns, 1U);
+
+    // Failed request
+    unit.resetStats();
+    dev.nackCommand(true);
+    EXPECT_FALSE(unit.startPeriodicMeasurement(2));
+    dev.nackCommand(false);
+    s = unit.stats();
+    EXPECT_EQ(s.request_failures, 1U);
+    EXPECT_EQ(s.bus_bytes, 1U);
+
+    // Timeouts
+    SimRCWL9620::config_t tcfg{};
+    tcfg.nacks = 1000;
+    SimRCWL9620 dev2(tcfg);
+    SimDeviceUnit timeout(dev2, Adapter::Type::I2C, 4);
+    auto cfg                  = timeout.config();
+    cfg.readiness.deadline_ms = 0;
+    timeout.config(cfg);
+    ASSERT_TRUE(timeout.begin());
+    ASSERT_TRUE(timeout.startPeriodicMeasurement(2));
+    tick(timeout, 3 * 1000);
+    timeout.update();
+    EXPECT_TRUE(timeout.stopPeriodicMeasurement());
+    s = timeout.stats();
+    EXPECT_GE(s.timeouts, 1U);
+    EXPECT_EQ(s.samples, 0U);
+
+    // No bus bytes for GPIO
+    SimRCWL9620 dev3{};
+    SimDeviceUnit gpio(dev3, Adapter::Type::GPIO, 4);
+    ASSERT_TRUE(gpio.begin());
+    ASSERT_TRUE(gpio.startPeriodicMeasurement(1));
+    EXPECT_TRUE(collect_periodic(gpio, 2));
+    EXPECT_TRUE(gpio.stopPeriodicMeasurement());
+    s = gpio.stats();
+    EXPECT_GE(s.samples, 2U);
+    EXPECT_EQ(s.bus_bytes, 0U);
+
+    // Lateness from the scheduled time even if the echo is measured in the read (GPIO without the capture)
+    gpio.resetStats();
+    ASSERT_TRUE(gpio.startPeriodicMeasurement(2));
+    tick(gpio, 10 * 1000);
+    gpio.update();
+    EXPECT_TRUE(gpio.updated());
+    EXPECT_TRUE(gpio.stopPeriodicMeasurement());
+    s = gpio.stats();
+    EXPECT_EQ(s.lateness_us.count, 1U);
+    EXPECT_GE(s.lateness_us.max, 2000U);
+    EXPECT_EQ(s.overruns, 1U);
+}
+
+TEST(RCWL9620, Telemetry)
+{
+    using namespace m5::unit::rcwl9620::telemetry;
+
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(crc16(check, sizeof(check)), 0x29B1);
+
+    std::vector<std::pair<header_t, std::vector<uint32_t>>> decoded{};
+    std::vector<uint32_t> times{};
+    Decoder decoder([&decoded, &times](const header_t& h, const uint32_t* um, const uint32_t* ms, const size_t n) {
+        decoded.emplace_back(h, std::vector<uint32_t>(um, um + n));
+        times.assign(ms, ms + n);
+    });
+
+    // Round trip of Data, including the extremes
+    const uint32_t values[] = {1000000, 1000123, 999000, 0, 0xFFFFFF, 20000, 4500000, 4500000};
+    Data data[8]{};
+    for (size_t i = 0; i < 8; ++i) {
+        data[i].raw = {(uint8_t)(values[i] >> 16), (uint8_t)(values[i] >> 8), (uint8_t)values[i]};
+    }
+    header_t h{};
+    h.unit_id      = 3;
+    h.timestamp_ms = 0x12345678;
+    h.interval_ms  = 150;
+    uint8_t frame[max_frame_size(8)]{};
+    const size_t len = encode(frame, sizeof(frame), h, data, 8);
+    ASSERT_GT(len, 0U);
+    EXPECT_LE(len, max_frame_size(8));
+    EXPECT_EQ(decoder.feed(frame, len), 1U);
+    ASSERT_EQ(decoded.size(), 1U);
+    EXPECT_EQ(decoded[0].first.unit_id, 3U);
+    EXPECT_EQ(decoded[0].first.count, 8U);
+    EXPECT_EQ(decoded[0].first.timestamp_ms, 0x12345678U);
+    EXPECT_EQ(decoded[0].first.interval_ms, 150U);
+    EXPECT_EQ(decoded[0].second, std::vector<uint32_t>(values, values + 8));
+    ASSERT_EQ(times.size(), 8U);
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(times[i], 0x12345678U + 150U * i) << i;  // On time
+    }
+
+    // Each sample keeps its time through the drops, the jitter and the wrap around
+    const uint32_t ms[] = {0xFFFFFF00, 0xFFFFFF96, 0x00000122, 0x000001B9, 0x00000300, 0x00000300, 0x7FFFFFFF, 0};
+    h.timestamp_ms      = ms[0];
+    decoded.clear();
+    const size_t tlen = encode(frame, sizeof(frame), h, data, 8, ms);
+    ASSERT_GT(tlen, 0U);
+    EXPECT_EQ(decoder.feed(frame, tlen), 1U);
+    ASSERT_EQ(decoded.size(), 1U);
+    EXPECT_EQ(decoded[0].second, std::vector<uint32_t>(values, values + 8));
+    EXPECT_EQ(times, std::vector<uint32_t>(ms, ms + 8));
+    h.timestamp_ms = 0x12345678;
+
+    // Stream with the garbage, the corrupted frame and the fragments
+    std::vector<uint8_t> stream{'>', 'x', SYNC0, SYNC0, SYNC1, 0x00};
+    uint32_t um[16]{};
+    for (uint32_t f = 0; f < 3; ++f) {
+        for (uint32_t i = 0; i < 16; ++i) {
+            um[i] = 1000000 + f * 1000 + i * 7;
+        }
+        h.unit_id      = f;
+        h.timestamp_ms = f * 16 * 150;
+        const size_t l = encode(frame, sizeof(frame), h, um, 8);
+        ASSERT_GT(l, 0U);
+        if (f == 1) {
+            frame[HEADER_SIZE + 1] ^= 0x01;
+        }
+        stream.insert(stream.end(), frame, frame + l);
+        stream.push_back(SYNC0);
+    }
+    decoded.clear();
+    for (auto&& b : stream) {
+        decoder.feed(&b, 1);
+    }
+    ASSERT_EQ(decoded.size(), 2U);
+    EXPECT_EQ(decoded[0].first.unit_id, 0U);
+    EXPECT_EQ(decoded[1].first.unit_id, 2U);
+    EXPECT_EQ(decoded[1].first.timestamp_ms, 2U * 16 * 150);
+    EXPECT_EQ(decoded[1].second, std::vector<uint32_t>(um, um + 8));
+    auto c = decoder.counters();
+    EXPECT_EQ(c.frames, 4U);
+    EXPECT_EQ(c.samples, 32U);
+    EXPECT_EQ(c.crc_errors, 1U);
+    EXPECT_GT(c.skipped, 0U);
+
+    // Full
+    std::vector<uint8_t> large(max_frame_size(MAX_SAMPLES));
+    Encoder enc(large.data(), large.size());
+    EXPECT_FALSE(enc.push(0));  // Not begun
+    EXPECT_EQ(enc.finish(), 0U);
+    ASSERT_TRUE(enc.begin(h));
+    EXPECT_EQ(enc.finish(), 0U);  // No samples
+    ASSERT_TRUE(enc.begin(h));
+    uint32_t at = h.timestamp_ms;
+    for (uint32_t i = 0; i < MAX_SAMPLES; ++i) {
+        // Largest differences of the distance and the time
+        at = (i ? at + h.interval_ms : at) + 0x80000000U;
+        EXPECT_TRUE(enc.push((i & 1) ? 0 : 0xFFFFFF, at));
+    }
+    EXPECT_TRUE(enc.full());
+    EXPECT_FALSE(enc.push(0));
+    const size_t ll = enc.finish();
+    EXPECT_EQ(ll, max_frame_size(MAX_SAMPLES));
+    decoded.clear();
+    EXPECT_EQ(decoder.feed(large.data(), ll), 1U);
+    ASSERT_EQ(decoded.size(), 1U);
+    EXPECT_EQ(decoded[0].second.size(), MAX_SAMPLES);
+    EXPECT_EQ(decoded[0].second.back(), 0xFFFFFFU);
+    EXPECT_EQ(times.back(), at);
+
+    // Buffer is too small
+    EXPECT_EQ(encode(frame, max_frame_size(2), h, data, 8), 0U);
+    EXPECT_EQ(encode(frame, HEADER_SIZE, h, um, 1), 0U);
+
+    // Compact for the stationary target
+    for (uint32_t i = 0; i < 16; ++i) {
+        um[i] = 1000000 + ((i * 2654435761U) >> 20) % 6000;
+    }
+    uint8_t f16[max_frame_size(16)]{};
+    EXPECT_LE(encode(f16, sizeof(f16), h, um, 16), HEADER_SIZE + CRC_SIZE + 3 + 15 * 2 + 16);
+}
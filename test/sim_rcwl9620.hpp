@@ -0,0 +1,358 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Simulated RCWL9620 for native test and benchmark
+*/
+#ifndef M5_UNIT_DISTANCE_TEST_SIM_RCWL9620_HPP
+#define M5_UNIT_DISTANCE_TEST_SIM_RCWL9620_HPP
+
+#include <unit/unit_RCWL9620.hpp>
+#include <unit/rcwl9620/interface.hpp>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace rcwl9620 {
+
+// Simulated time, advanced only by the wait of the unit or advance()
+class FakeClock : public Clock {
+public:
+    // Starts at 1s, so that the time 0 is not confused with unset
+    explicit FakeClock(const uint64_t start_us = 1000 * 1000U) : _us{start_us}
+    {
+    }
+
+    virtual types::elapsed_time_t millis() const override
+    {
+        return _us.load() / 1000U;
+    }
+    virtual uint32_t micros() const override
+    {
+        return (uint32_t)_us.load();
+    }
+    virtual void delay(const uint32_t ms) override
+    {
+        ++waits;
+        _us += ms * 1000ULL;
+    }
+    virtual void delayMicroseconds(const uint32_t us) override
+    {
+        ++waits;
+        _us += us;
+    }
+    // Advance the time without counting as the wait of the unit
+    inline void advance(const uint64_t us)
+    {
+        _us += us;
+    }
+
+    // Number of the waits by the unit
+    std::atomic<uint32_t> waits{};
+
+private:
+    std::atomic<uint64_t> _us{};
+};
+
+// Device model answers the command, the 3 bytes read and the trigger pin
+class SimRCWL9620 {
+public:
+    struct config_t {
+        // Ranging time, the read is NACKed until elapsed (us)
+        uint32_t latency_us{1000};
+        // Additional NACKs after the ranging for each request
+        uint32_t nacks{0};
+        // NACK the command
+        bool write_nack{false};
+        // No echo pulse (e.g. out of range)
+        bool no_echo{false};
+        // From the trigger to the rising edge of the echo (us)
+        uint32_t echo_delay_us{500};
+        // Speed of sound for the echo pulse width (cm/s)
+        uint32_t speed_cm_s{SPEED_OF_SOUND};
+        // Record the ranging windows (I2C)
+        bool record_windows{false};
+    };
+
+    SimRCWL9620()
+    {
+    }
+    explicit SimRCWL9620(const config_t& cfg) : _cfg{cfg}
+    {
+    }
+
+    // Clock of the device, the own FakeClock by default
+    inline Clock& clock()
+    {
+        return *_clock;
+    }
+    // Use the clock instead of the own FakeClock (e.g. Clock::system() for the background task)
+    inline void attachClock(Clock* clock)
+    {
+        _clock = clock ? clock : &_fake;
+    }
+    // Own FakeClock
+    inline FakeClock& fakeClock()
+    {
+        return _fake;
+    }
+
+    inline const config_t& config() const
+    {
+        return _cfg;
+    }
+    inline void config(const config_t& cfg)
+    {
+        _cfg = cfg;
+    }
+    // Distances (um) measured in order, repeated
+    inline void trace(const std::vector<uint32_t>& um)
+    {
+        _trace = um;
+        _pos   = 0;
+    }
+    // NACK the command, can be called while the unit runs in the background task
+    inline void nackCommand(const bool nack)
+    {
+        _nack_command.store(nack);
+    }
+    // Echo pulse width of the distance (us)
+    static uint32_t echo_us(const uint32_t um, const uint32_t speed_cm_s = SPEED_OF_SOUND)
+    {
+        return static_cast<uint32_t>(((uint64_t)um * 200U + speed_cm_s - 1) / speed_cm_s);
+    }
+
+    ///@name I2C
+    ///@{
+    bool write(const uint8_t cmd)
+    {
+        ++writes;
+        if (_cfg.write_nack || _nack_command.load() || cmd != command::MEASURE_DISTANCE) {
+            return false;
+        }
+        _ranging    = true;
+        _started_us = _clock->micros();
+        _nacks      = _cfg.nacks;
+        return true;
+    }
+    bool read(uint8_t* buf, const size_t len)
+    {
+        ++reads;
+        if (len != 3) {
+            return false;
+        }
+        if (_ranging) {
+            if (_clock->micros() - _started_us < _cfg.latency_us) {
+                ++nacked;
+                return false;
+            }
+            if (_nacks) {
+                --_nacks;
+                ++nacked;
+                return false;
+            }
+            _ranging = false;
+            _last    = next();
+            if (_cfg.record_windows) {
+                windows.push_back({_started_us, _clock->micros()});
+            }
+        }
+        // Returns the last result if not requested
+        buf[0] = _last >> 16;
+        buf[1] = _last >> 8;
+        buf[2] = _last;
+        return true;
+    }
+    ///@}
+
+    ///@name GPIO
+    ///@{
+    // Feeds the edges to the capture if attached
+    inline void attach(EchoCapture* capture)
+    {
+        _capture = capture;
+    }
+    // Trigger pin, ranging starts at the falling edge
+    void pin(const bool high)
+    {
+        if (_trigger && !high) {
+            ++writes;
+            _echo  = !_cfg.no_echo;
+            _width = echo_us(next(), _cfg.speed_cm_s);
+            if (_capture && _echo) {
+                auto at = _clock->micros() + _cfg.echo_delay_us;
+                _capture->edge(true, at);
+                _capture->edge(false, at + _width);
+            }
+        }
+        _trigger = high;
+    }
+    // Echo pulse width without waiting for it
+    bool pulse(uint32_t& duration, const uint32_t timeout_us)
+    {
+        ++reads;
+        const bool echo = _echo;
+        _echo           = false;
+        if (!echo || _width > timeout_us) {
+            ++nacked;
+            return false;
+        }
+        duration = _width;
+        return true;
+    }
+    ///@}
+
+    // Transactions on the bus
+    inline uint32_t transactions() const
+    {
+        return writes + reads;
+    }
+
+    // Ranging from the command to the read of the result (us)
+    struct window_t {
+        uint32_t from, to;
+    };
+    std::vector<window_t> windows{};
+
+    uint32_t writes{}, reads{}, nacked{}, measured{};
+
+protected:
+    uint32_t next()
+    {
+        ++measured;
+        uint32_t um = _trace.empty() ? 1000000U : _trace[_pos++ % _trace.size()];
+        return um > 0xFFFFFFU ? 0xFFFFFFU : um;
+    }
+
+private:
+    FakeClock _fake{};
+    Clock* _clock{&_fake};
+    config_t _cfg{};
+    std::vector<uint32_t> _trace{};
+    size_t _pos{};
+    uint32_t _last{}, _started_us{}, _nacks{}, _width{};
+    bool _ranging{}, _trigger{}, _echo{};
+    EchoCapture* _capture{};
+    std::atomic<bool> _nack_command{};
+};
+
+// Ranging window of the devices on the same bus
+struct bus_window_t {
+    size_t device;  // Index of the device
+    SimRCWL9620::window_t window;
+};
+
+// Ranging windows of the devices, ordered by the start
+inline std::vector<bus_window_t> bus_windows(const std::vector<const SimRCWL9620*>& devs)
+{
+    std::vector<bus_window_t> v{};
+    for (size_t i = 0; i < devs.size(); ++i) {
+        for (auto&& w : devs[i]->windows) {
+            v.push_back({i, w});
+        }
+    }
+    std::stable_sort(v.begin(), v.end(),
+                     [](const bus_window_t& a, const bus_window_t& b) { return a.window.from < b.window.from; });
+    return v;
+}
+
+// Maximum number of the devices ranging at the same time
+inline uint32_t max_overlap(const std::vector<const SimRCWL9620*>& devs)
+{
+    auto v = bus_windows(devs);
+    uint32_t mx{};
+    for (auto&& w : v) {
+        uint32_t cnt{};
+        for (auto&& o : v) {
+            cnt += (o.window.from <= w.window.from && w.window.from < o.window.to);
+        }
+        mx = std::max(mx, cnt);
+    }
+    return mx;
+}
+
+class SimInterfaceI2C : public InterfaceI2C {
+public:
+    SimInterfaceI2C(UnitRCWL9620& u, SimRCWL9620& dev) : InterfaceI2C(u), _dev{dev}
+    {
+    }
+    virtual uint32_t ranging_time() const override
+    {
+        return (_dev.config().latency_us + 999) / 1000;
+    }
+
+protected:
+    virtual bool write_command(const uint8_t cmd) override
+    {
+        return _dev.write(cmd);
+    }
+    virtual bool read_raw(uint8_t* buf, const size_t len) override
+    {
+        return _dev.read(buf, len);
+    }
+
+private:
+    SimRCWL9620& _dev;
+};
+
+class SimInterfaceGPIO : public InterfaceGPIO {
+public:
+    SimInterfaceGPIO(UnitRCWL9620& u, EchoCapture* capture, SimRCWL9620& dev) : InterfaceGPIO(u, capture), _dev{dev}
+    {
+        _dev.attach(capture);
+    }
+
+protected:
+    virtual void write_trigger(const bool high) override
+    {
+        _dev.pin(high);
+    }
+    virtual bool pulse_in(uint32_t& duration, const uint32_t timeout_us) override
+    {
+        return _dev.pulse(duration, timeout_us);
+    }
+
+private:
+    SimRCWL9620& _dev;
+};
+
+// Unit connected to the simulated device, on the clock of the device
+class SimDeviceUnit : public UnitRCWL9620 {
+public:
+    SimDeviceUnit(SimRCWL9620& dev, const Adapter::Type type = Adapter::Type::I2C, const uint32_t stored = 8)
+        : UnitRCWL9620(), _dev{dev}, _type{type}
+    {
+        auto cfg           = config();
+        cfg.start_periodic = false;
+        config(cfg);
+        auto ccfg        = component_config();
+        ccfg.stored_size = stored;
+        component_config(ccfg);
+        attachClock(&dev.clock());
+    }
+
+protected:
+    virtual Interface* create_interface(const Adapter::Type) override
+    {
+        return _type == Adapter::Type::GPIO ? make_interface<SimInterfaceGPIO>(*this, echoCapture(), _dev)
+                                            : make_interface<SimInterfaceI2C>(*this, _dev);
+    }
+    // Not limited by the real ranging time
+    virtual uint32_t minimum_interval() const override
+    {
+        return 1;
+    }
+
+private:
+    SimRCWL9620& _dev;
+    Adapter::Type _type{};
+};
+
+}  // namespace rcwl9620
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Host decoder of the binary telemetry of RCWL9620 (Linux)
+  Prints the samples as CSV (unit,time_ms,distance_mm)
+
+  Build:
+    g++ -std=c++11 -O2 -I../../src/unit/rcwl9620 telemetry_decoder.cpp ../../src/unit/rcwl9620/telemetry.cpp \
+      -o telemetry_decoder
+  Usage:
+    telemetry_decoder /dev/ttyUSB0 [baud]  (115200 by default)
+    telemetry_decoder capture.bin
+    cat capture.bin | telemetry_decoder -
+*/
+#include "telemetry.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace m5::unit::rcwl9620::telemetry;
+
+namespace {
+
+speed_t to_speed(const long baud)
+{
+    switch (baud) {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 115200:
+            return B115200;
+        case 230400:
+            return B230400;
+        case 460800:
+            return B460800;
+        case 921600:
+            return B921600;
+        case 1500000:
+            return B1500000;
+        default:
+            return 0;
+    }
+}
+
+// Raw mode if the file is a terminal
+bool configure(const int fd, const long baud)
+{
+    if (!isatty(fd)) {
+        return true;
+    }
+    const speed_t speed = to_speed(baud);
+    if (!speed) {
+        fprintf(stderr, "Unsupported baud rate: %ld\n", baud);
+        return false;
+    }
+    termios tio{};
+    if (tcgetattr(fd, &tio) != 0) {
+        perror("tcgetattr");
+        return false;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        perror("tcsetattr");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <device|file|-> [baud]\n", argv[0]);
+        return 1;
+    }
+    const bool from_stdin = std::strcmp(argv[1], "-") == 0;
+    const int fd          = from_stdin ? STDIN_FILENO : open(argv[1], O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    if (!configure(fd, argc > 2 ? std::strtol(argv[2], nullptr, 10) : 115200)) {
+        return 1;
+    }
+
+    printf("unit,time_ms,distance_mm\n");
+    Decoder decoder([](const header_t& h, const uint32_t* um, const uint32_t* ms, const size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            printf("%u,%u,%u.%03u\n", h.unit_id, (unsigned)ms[i], um[i] / 1000, um[i] % 1000);
+        }
+        fflush(stdout);
+    });
+
+    uint8_t buf[256]{};
+    ssize_t len{};
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        decoder.feed(buf, (size_t)len);
+    }
+
+    auto& c = decoder.counters();
+    fprintf(stderr, "frames:%u samples:%u crc_errors:%u malformed:%u skipped:%u\n", c.frames, c.samples, c.crc_errors,
+            c.malformed, c.skipped);
+    if (!from_stdin) {
+        close(fd);
+    }
+    return 0;
+}